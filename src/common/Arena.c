@@ -11,24 +11,80 @@
 // Function | Purpose
 // --- | ---
 // Arena__alloc(sz) | Allocate new arena with given size
-// Arena__zero(arena) | Zero entire arena buffer (SLOW)
-// Arena__allocZ(sz) | Allocate + zero-initialize arena
+// Arena__reserve(sz, keep) | Reserve sz of address space; commit pages on demand
+// Arena__allocFlags(sz, flags) | Allocate OS-mapped arena (huge pages, prefault)
+// Arena__backing(a) | Name of the physical backing obtained
+// Arena__zero(arena) | Zero arena buffer (only the dirty prefix)
+// Arena__allocZ(sz) | Allocate + zero-initialize arena (calloc; no memset)
 // Arena__zeroRange(p, sz) | Zero specific memory range (SLOW)
 // Arena__cap(a) | Get arena capacity in bytes
 // Arena__used(a) | Get used bytes in arena
 // Arena__remain(a) | Get remaining bytes in arena
 // Arena__ptr(arena, ptr) | Check if pointer is within arena bounds
 // Arena__push(a, sz) | Allocate block from arena (primary function)
+// Arena__pushZ(a, sz) | Allocate zeroed block; only clears bytes that were ever used
+// Arena__pushAligned(a, sz, align) | Allocate block at a multiple of align (power of 2)
+// Arena__pushAlignedZ(a, sz, align) | Aligned + zeroed
+// Arena__pushStruct(a, T) | Allocate one T, aligned to _Alignof(T)
+// Arena__pushArray(a, T, n) | Allocate n T, aligned to _Alignof(T) (+ Z variants)
+// Arena__pushCacheline(a, sz) | Allocate whole cache lines (no false sharing with neighbours)
 // Arena__free(a) | Free arena buffer
 // Arena__reset(a) | Reset arena position to beginning
+// Arena__resetZ(a) | Reset + zero used range (page decommit for large ranges)
+// Arena__prefault(a) | Touch every page so later pushes never page-fault
+// Arena__printf(a, name) | Print peak, top push call sites + reset history (ARENA__INSTRUMENTED)
+
+// @class ArenaTemp
+// Function | Purpose
+// --- | ---
+// ArenaTemp__begin(a) | Save arena position
+// ArenaTemp__end(t) | Roll arena back to saved position (frees later pushes)
+
+static Arena* _Arena__heap(u64 sz, bool zeroed) {
+  Arena* arena = (Arena*)calloc(1, sizeof(Arena));
+  if (!arena)
+    return NULL;
+
+  // calloc gets fresh (already zero) pages from the OS for large sizes; no memset
+  arena->buf = (u8*)(zeroed ? calloc(1, sz) : malloc(sz));
+  if (!arena->buf) {
+    free(arena);
+    return NULL;
+  }
+
+  arena->pos = arena->buf;
+  arena->end = arena->buf + sz;
+  arena->commit = arena->end;
+  arena->keep = ARENA__KEEP_ALL;
+  arena->dirty = zeroed ? arena->buf : arena->end;  // malloc'd contents are unknown
+  arena->flags = 0;
+  arena->backing = ARENA_HEAP;
+  return arena;
+}
 
 // malloc a new arena (used exactly once in each process/thread)
 Arena* Arena__alloc(u64 sz) {
-  Arena* arena = (Arena*)malloc(sizeof(Arena));
+  return _Arena__heap(sz, false);
+}
+
+// reserve sz of address space (no physical memory); pages commit as pushes reach them,
+// so pointers stay stable and the arena can be sized for the worst case.
+// keep = bytes Arena__reset() leaves committed (0 = release all, ARENA__KEEP_ALL = none)
+Arena* Arena__reserve(u64 sz, u64 keep) {
+  Arena* arena = (Arena*)calloc(1, sizeof(Arena));
   if (!arena)
     return NULL;
 
-  arena->buf = (u8*)malloc(sz);
+  sz = (sz + ARENA__COMMIT_SZ - 1) & ~(u64)(ARENA__COMMIT_SZ - 1);
+#ifdef _WIN32
+  arena->buf = (u8*)VirtualAlloc(NULL, sz, MEM_RESERVE, PAGE_NOACCESS);
+#elif __linux__
+  void* p = mmap(NULL, sz, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+  arena->buf = MAP_FAILED == p ? NULL : (u8*)p;
+#else
+  free(arena);
+  return Arena__alloc(sz);  // no virtual memory control; plain heap
+#endif
   if (!arena->buf) {
     free(arena);
     return NULL;
@@ -36,23 +92,220 @@ Arena* Arena__alloc(u64 sz) {
 
   arena->pos = arena->buf;
   arena->end = arena->buf + sz;
+  arena->commit = arena->buf;  // OS zero-fills each page on first commit
+  arena->keep = keep;
+  arena->dirty = arena->buf;
+  arena->flags = ARENA__VM;
+  arena->backing = ARENA_PAGES;
   return arena;
 }
 
-// zero a whole arena
-// WARN: memset() is VERY SLOW!
+// touch every page up front, so later pushes never page-fault (contents preserved)
+void Arena__prefault(Arena* a) {
+  ASSERT_CONTEXT(a && a->buf, "Arena is NULL or uninitialized");
+  volatile u8* p = a->buf;
+  for (u64 i = 0; i < (u64)(a->commit - a->buf); i += ARENA__PAGE_SZ) {
+    p[i] = p[i];
+  }
+}
+
+#ifdef __linux__
+// map sz bytes aligned to a huge page, so THP can back it with 2MB pages
+static u8* _Arena__mapAligned(u64 sz) {
+  u64 over = sz + ARENA__HUGE_PAGE_SZ;
+  u8* p = (u8*)mmap(NULL, over, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (MAP_FAILED == (void*)p) {
+    return NULL;
+  }
+  u8* aligned =
+      (u8*)(((uintptr_t)p + ARENA__HUGE_PAGE_SZ - 1) & ~(uintptr_t)(ARENA__HUGE_PAGE_SZ - 1));
+  if (aligned > p) {
+    munmap(p, aligned - p);  // trim head
+  }
+  if (aligned + sz < p + over) {
+    munmap(aligned + sz, (p + over) - (aligned + sz));  // trim tail
+  }
+  return aligned;
+}
+#endif
+
+// Allocate OS-mapped arena (huge pages, prefault); fixed size, never grows
+// flags: ARENA__HUGE (2MB pages; falls back to THP, then base pages)
+//        ARENA__POPULATE (fault every page in now, not on first push)
+// check a->backing / Arena__backing(a) for what the OS actually granted
+Arena* Arena__allocFlags(u64 sz, u32 flags) {
+  Arena* arena = (Arena*)calloc(1, sizeof(Arena));
+  if (!arena)
+    return NULL;
+
+  arena->buf = NULL;
+  arena->flags = ARENA__MAPPED;
+  arena->backing = ARENA_PAGES;
+  if (flags & ARENA__HUGE) {
+    sz = (sz + ARENA__HUGE_PAGE_SZ - 1) & ~(u64)(ARENA__HUGE_PAGE_SZ - 1);
+  } else {
+    sz = (sz + ARENA__PAGE_SZ - 1) & ~(u64)(ARENA__PAGE_SZ - 1);
+  }
+
+#ifdef _WIN32
+  if (flags & ARENA__HUGE) {
+    // needs SeLockMemoryPrivilege; large pages are always committed + resident
+    arena->buf = (u8*)VirtualAlloc(
+        NULL,
+        sz,
+        MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES,
+        PAGE_READWRITE);
+    if (arena->buf) {
+      arena->backing = ARENA_HUGETLB;
+      arena->flags |= ARENA__POPULATED;
+    }
+  }
+  if (!arena->buf) {
+    arena->buf = (u8*)VirtualAlloc(NULL, sz, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+  }
+#elif __linux__
+  s32 populate = (flags & ARENA__POPULATE) ? MAP_POPULATE : 0;
+  if (flags & ARENA__HUGE) {
+    // needs pages reserved in /proc/sys/vm/nr_hugepages
+    void* p = mmap(
+        NULL,
+        sz,
+        PROT_READ | PROT_WRITE,
+        MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB | populate,
+        -1,
+        0);
+    if (MAP_FAILED != p) {
+      arena->buf = (u8*)p;
+      arena->backing = ARENA_HUGETLB;
+      arena->flags |= populate ? ARENA__POPULATED : 0;
+    } else {
+      // no reserved huge pages; let THP promote (populated below, after madvise)
+      arena->buf = _Arena__mapAligned(sz);
+      if (arena->buf && 0 == madvise(arena->buf, sz, MADV_HUGEPAGE)) {
+        arena->backing = ARENA_THP;
+      }
+    }
+  } else {
+    void* p = mmap(NULL, sz, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | populate, -1, 0);
+    arena->buf = MAP_FAILED == p ? NULL : (u8*)p;
+    arena->flags |= populate ? ARENA__POPULATED : 0;
+  }
+#else
+  free(arena);
+  return Arena__alloc(sz);  // no virtual memory control; plain heap
+#endif
+  if (!arena->buf) {
+    free(arena);
+    return NULL;
+  }
+
+  arena->pos = arena->buf;
+  arena->end = arena->buf + sz;
+  arena->commit = arena->end;
+  arena->keep = ARENA__KEEP_ALL;
+  arena->dirty = arena->buf;  // fresh mapping is zero-filled
+  if ((flags & ARENA__POPULATE) && !(arena->flags & ARENA__POPULATED)) {
+    Arena__prefault(arena);
+    arena->flags |= ARENA__POPULATED;
+  }
+  return arena;
+}
+
+// Name of the physical backing obtained
+const char* Arena__backing(Arena* a) {
+  switch (a->backing) {
+    case ARENA_HEAP:
+      return "heap";
+    case ARENA_PAGES:
+      return "4KB pages";
+    case ARENA_HUGETLB:
+      return "2MB hugetlb";
+    case ARENA_THP:
+      return "2MB THP (madvise)";
+  }
+  return "?";
+}
+
+// make [commit, pos) usable, growing in ARENA__COMMIT_SZ steps
+static bool _Arena__commit(Arena* a) {
+  if (!(a->flags & ARENA__VM) || a->pos > a->end) {
+    return false;
+  }
+  u64 used = (u64)(a->pos - a->buf);
+  u64 target = (used + ARENA__COMMIT_SZ - 1) & ~(u64)(ARENA__COMMIT_SZ - 1);
+  u8* to = a->buf + target < a->end ? a->buf + target : a->end;
+#ifdef _WIN32
+  if (!VirtualAlloc(a->commit, to - a->commit, MEM_COMMIT, PAGE_READWRITE)) {
+    return false;
+  }
+#elif __linux__
+  if (0 != mprotect(a->commit, to - a->commit, PROT_READ | PROT_WRITE)) {
+    return false;
+  }
+#endif
+  a->commit = to;
+  return true;
+}
+
+// return committed pages past `keep` to the OS (contents are lost)
+static void _Arena__decommit(Arena* a) {
+  if (!(a->flags & ARENA__VM) || ARENA__KEEP_ALL == a->keep) {
+    return;
+  }
+  u64 keep = (a->keep + ARENA__COMMIT_SZ - 1) & ~(u64)(ARENA__COMMIT_SZ - 1);
+  u8* from = keep < (u64)(a->end - a->buf) ? a->buf + keep : a->end;
+  if (a->commit <= from) {
+    return;
+  }
+#ifdef _WIN32
+  VirtualFree(from, a->commit - from, MEM_DECOMMIT);
+#elif __linux__
+  madvise(from, a->commit - from, MADV_DONTNEED);  // drop pages; next touch is zero-filled
+  mprotect(from, a->commit - from, PROT_NONE);
+#endif
+  a->commit = from;
+  if (a->dirty > from) {
+    a->dirty = from;
+  }
+}
+
+// furthest byte ever handed out (pos may have rolled back since)
+static inline u8* _Arena__dirtyEnd(Arena* a) {
+  return a->pos > a->dirty ? a->pos : a->dirty;
+}
+
+// zero [from, to); page-backed ranges past ARENA__DONTNEED_MIN are dropped instead,
+// and the kernel hands back zero pages lazily on next touch
+// prefaulted + huge-page arenas always memset: dropping would refault / split what
+// Arena__allocFlags() paid for up front
+static void _Arena__zeroPages(Arena* a, u8* from, u8* to) {
+#ifdef __linux__
+  bool keepPages = (a->flags & ARENA__POPULATED) || ARENA_HUGETLB == a->backing ||
+                   ARENA_THP == a->backing;
+  if ((a->flags & (ARENA__VM | ARENA__MAPPED)) && !keepPages &&
+      (u64)(to - from) >= ARENA__DONTNEED_MIN) {
+    u8* p0 = (u8*)(((uintptr_t)from + ARENA__PAGE_SZ - 1) & ~(uintptr_t)(ARENA__PAGE_SZ - 1));
+    u8* p1 = (u8*)((uintptr_t)to & ~(uintptr_t)(ARENA__PAGE_SZ - 1));
+    if (0 == madvise(p0, p1 - p0, MADV_DONTNEED)) {
+      memset(from, 0, p0 - from);  // partial head + tail pages
+      memset(p1, 0, to - p1);
+      return;
+    }
+  }
+#endif
+  memset(from, 0, to - from);
+}
+
+// zero a whole arena (contents + pos kept; only the dirty prefix is touched)
 void Arena__zero(Arena* arena) {
   ASSERT_CONTEXT(arena && arena->buf, "Arena is NULL or uninitialized");
-  memset(arena->buf, 0, arena->end - arena->buf);
+  _Arena__zeroPages(arena, arena->buf, _Arena__dirtyEnd(arena));
+  arena->dirty = arena->buf;
 }
 
 // alloc + zero-init
 Arena* Arena__allocZ(u64 sz) {
-  Arena* arena = Arena__alloc(sz);
-  if (arena) {
-    Arena__zero(arena);
-  }
-  return arena;
+  return _Arena__heap(sz, true);
 }
 
 // zero an individual var (ie. for reuse)
@@ -63,21 +316,21 @@ void Arena__zeroRange(u8* p, u64 sz) {
 }
 
 // return capacity in bytes
-static inline u32 Arena__cap(Arena* a) {
+static inline u64 Arena__cap(Arena* a) {
   ASSERT_CONTEXT(a && a->buf, "Arena is NULL or uninitialized");
-  return (u32)(a->end - a->buf);
+  return (u64)(a->end - a->buf);
 }
 
 // return used in bytes
-static inline u32 Arena__used(Arena* a) {
+static inline u64 Arena__used(Arena* a) {
   ASSERT_CONTEXT(a && a->buf, "Arena is NULL or uninitialized");
-  return (u32)(a->pos - a->buf);
+  return (u64)(a->pos - a->buf);
 }
 
 // return remaining in bytes
-static inline u32 Arena__remain(Arena* a) {
+static inline u64 Arena__remain(Arena* a) {
   ASSERT_CONTEXT(a && a->buf, "Arena is NULL or uninitialized");
-  return (u32)(a->end - a->pos);
+  return (u64)(a->end - a->pos);
 }
 
 // is pointer inside arena space? (prevent segfault)
@@ -87,32 +340,279 @@ static inline bool Arena__ptr(Arena* arena, void* ptr) {
   return p >= arena->buf && p < arena->end;
 }
 
+#ifdef ARENA__INSTRUMENTED
+// attribute a push to its call site; updates peak
+static void _Arena__track(Arena* a, u64 sz, const char* file, u32 line) {
+  ArenaStats* s = a->stats;
+  if (NULL == s) {
+    s = a->stats = (ArenaStats*)calloc(1, sizeof(ArenaStats));
+    if (NULL == s) {
+      return;
+    }
+  }
+  u64 used = (u64)(a->pos - a->buf);
+  if (used > s->peak) {
+    s->peak = used;
+  }
+  s->pushes++;
+  // __FILE__ literals are merged within the unity build, so the pointer identifies the file
+  u32 h = (u32)((uintptr_t)file >> 3) * 2654435761u + line;
+  for (u32 i = 0; i < ARENA__MAX_SITES; i++) {
+    ArenaSite* site = &s->sites[(h + i) & (ARENA__MAX_SITES - 1)];
+    if (NULL == site->file) {
+      site->file = file;
+      site->line = line;
+      s->siteCt++;
+    }
+    if (site->file == file && site->line == line) {
+      site->pushes++;
+      site->bytes += sz;
+      return;
+    }
+  }
+  s->dropped += sz;
+}
+
+// record bytes in use as the arena is reset (once per tick for frame arenas)
+static void _Arena__sample(Arena* a) {
+  if (NULL != a->stats) {
+    a->stats->history[a->stats->resets++ % ARENA__HISTORY_CT] = (u64)(a->pos - a->buf);
+  }
+}
+#endif
+
 // reserve a block of memory from the area (most commonly used function)
 void* Arena__push(Arena* a, u64 sz) {
   ASSERT_CONTEXT(a && a->buf, "Arena is NULL or uninitialized");
   ASSERT_CONTEXT(
       a->pos + sz <= a->end,
       "Arena exhausted. requested %llu bytes, available %llu bytes",
-      sz,
-      Arena__remain(a));
+      (unsigned long long)sz,
+      (unsigned long long)Arena__remain(a));
 
   void* result = a->pos;
   a->pos += sz;
+  if (a->pos > a->commit && !_Arena__commit(a)) {
+    a->pos -= sz;
+    return NULL;  // out of reserve (or OS refused to commit)
+  }
   return result;
 }
 
+// reserve a zeroed block; bytes past the high-water mark are already zero
+void* Arena__pushZ(Arena* a, u64 sz) {
+  u8* dirty = _Arena__dirtyEnd(a);
+  u8* p = (u8*)Arena__push(a, sz);
+  if (NULL != p && p < dirty) {
+    memset(p, 0, (p + sz < dirty ? p + sz : dirty) - p);
+  }
+  return p;
+}
+
+// bytes to skip so the next push starts on a multiple of align
+static inline u64 _Arena__pad(Arena* a, u64 align) {
+  ASSERT_CONTEXT(0 != align && 0 == (align & (align - 1)), "align %llu not a power of 2", align);
+  return (u64)(-(uintptr_t)a->pos & (uintptr_t)(align - 1));
+}
+
+// reserve a block starting at a multiple of align (power of 2); padding is lost until reset
+void* Arena__pushAligned(Arena* a, u64 sz, u64 align) {
+  u64 pad = _Arena__pad(a, align);
+  u8* p = (u8*)Arena__push(a, pad + sz);
+  return NULL != p ? p + pad : NULL;
+}
+
+// aligned + zeroed (see Arena__pushZ)
+void* Arena__pushAlignedZ(Arena* a, u64 sz, u64 align) {
+  u64 pad = _Arena__pad(a, align);
+  u8* p = (u8*)Arena__pushZ(a, pad + sz);
+  return NULL != p ? p + pad : NULL;
+}
+
+// typed pushes; u64/f64 fields + SIMD vectors come back naturally aligned
+#define Arena__pushStruct(a, T) ((T*)Arena__pushAligned((a), sizeof(T), _Alignof(T)))
+#define Arena__pushStructZ(a, T) ((T*)Arena__pushAlignedZ((a), sizeof(T), _Alignof(T)))
+#define Arena__pushArray(a, T, n)                                  \
+  ((T*)Arena__pushAligned((a), (u64)sizeof(T) * (n), _Alignof(T)))
+#define Arena__pushArrayZ(a, T, n)                                  \
+  ((T*)Arena__pushAlignedZ((a), (u64)sizeof(T) * (n), _Alignof(T)))
+
+// block that starts on a line and owns all of its lines; for data written by one thread
+// while others write their neighbours (per-thread counters, queues, accumulators)
+#define Arena__pushCacheline(a, sz) Arena__pushAligned((a), CACHELINE(sz), CACHELINE_SZ)
+
 // free the allocated memory
 void Arena__free(Arena* a) {
   if (a) {
-    if (a->buf) {
+    if (a->buf && (a->flags & (ARENA__VM | ARENA__MAPPED))) {
+#ifdef _WIN32
+      VirtualFree(a->buf, 0, MEM_RELEASE);
+#elif __linux__
+      munmap(a->buf, a->end - a->buf);
+#endif
+    } else if (a->buf) {
       free(a->buf);
     }
+#ifdef ARENA__INSTRUMENTED
+    free(a->stats);
+#endif
     free(a);
   }
 }
 
 // reset arena write ptr to beginning of arena
+// VM arenas also give pages beyond `keep` back to the OS
 void Arena__reset(Arena* a) {
   ASSERT_CONTEXT(a && a->buf, "Arena is NULL or uninitialized");
+#ifdef ARENA__INSTRUMENTED
+  _Arena__sample(a);
+#endif
+  a->dirty = _Arena__dirtyEnd(a);
   a->pos = a->buf;
+  _Arena__decommit(a);
+}
+
+// reset + zero everything used since the last zeroing; cost scales with the
+// high-water mark, not capacity (and large ranges are decommitted, not memset)
+void Arena__resetZ(Arena* a) {
+  ASSERT_CONTEXT(a && a->buf, "Arena is NULL or uninitialized");
+  Arena__reset(a);
+  _Arena__zeroPages(a, a->buf, a->dirty);
+  a->dirty = a->buf;
+}
+
+// ---
+// ArenaTemp
+
+// Save arena position
+static inline ArenaTemp ArenaTemp__begin(Arena* a) {
+  ASSERT_CONTEXT(a && a->buf, "Arena is NULL or uninitialized");
+  return (ArenaTemp){.arena = a, .pos = a->pos};
+}
+
+// Roll arena back to saved position (frees later pushes)
+// temps nest like a stack; end inner ones first
+static inline void ArenaTemp__end(ArenaTemp t) {
+  ASSERT_CONTEXT(t.pos <= t.arena->pos, "ArenaTemp ended out of order");
+  t.arena->dirty = _Arena__dirtyEnd(t.arena);
+  t.arena->pos = t.pos;
+}
+
+// ---
+// Instrumentation
+
+#ifdef ARENA__INSTRUMENTED
+#define ARENA__REPORT_SITES (10)
+
+static void* _Arena__pushAt(Arena* a, u64 sz, const char* file, u32 line) {
+  void* p = Arena__push(a, sz);
+  if (NULL != p) {
+    _Arena__track(a, sz, file, line);
+  }
+  return p;
+}
+
+static void* _Arena__pushZAt(Arena* a, u64 sz, const char* file, u32 line) {
+  void* p = Arena__pushZ(a, sz);
+  if (NULL != p) {
+    _Arena__track(a, sz, file, line);
+  }
+  return p;
+}
+
+static void* _Arena__pushAlignedAt(Arena* a, u64 sz, u64 align, const char* file, u32 line) {
+  void* p = Arena__pushAligned(a, sz, align);
+  if (NULL != p) {
+    _Arena__track(a, sz, file, line);
+  }
+  return p;
+}
+
+static void* _Arena__pushAlignedZAt(Arena* a, u64 sz, u64 align, const char* file, u32 line) {
+  void* p = Arena__pushAlignedZ(a, sz, align);
+  if (NULL != p) {
+    _Arena__track(a, sz, file, line);
+  }
+  return p;
+}
+
+// from here on, every push is attributed to the line that made it
+#define Arena__push(a, sz) _Arena__pushAt((a), (sz), __FILE__, __LINE__)
+#define Arena__pushZ(a, sz) _Arena__pushZAt((a), (sz), __FILE__, __LINE__)
+#define Arena__pushAligned(a, sz, align)                        \
+  _Arena__pushAlignedAt((a), (sz), (align), __FILE__, __LINE__)
+#define Arena__pushAlignedZ(a, sz, align)                        \
+  _Arena__pushAlignedZAt((a), (sz), (align), __FILE__, __LINE__)
+
+// Print peak, top push call sites + reset history (ARENA__INSTRUMENTED)
+// use ARENA__PRINT(a, name) so release builds compile it out
+void Arena__printf(Arena* a, const char* name) {
+  LOG_DEBUGF("\nArena %s (%s):", name, Arena__backing(a));
+  ArenaStats* s = a->stats;
+  LOG_DEBUGF(
+      "  cap %llu KB  committed %llu KB  used %llu KB  peak %llu KB",
+      (u64)(a->end - a->buf) / 1024,
+      (u64)(a->commit - a->buf) / 1024,
+      (u64)(a->pos - a->buf) / 1024,
+      NULL != s ? s->peak / 1024 : 0);
+  if (NULL == s) {
+    return;
+  }
+
+  // top sites by bytes (insertion into a short sorted list)
+  ArenaSite* top[ARENA__REPORT_SITES] = {0};
+  for (u32 i = 0; i < ARENA__MAX_SITES; i++) {
+    ArenaSite* site = &s->sites[i];
+    if (NULL == site->file) {
+      continue;
+    }
+    for (u32 j = 0; j < ARENA__REPORT_SITES; j++) {
+      if (NULL == top[j] || site->bytes > top[j]->bytes) {
+        memmove(&top[j + 1], &top[j], (ARENA__REPORT_SITES - 1 - j) * sizeof(ArenaSite*));
+        top[j] = site;
+        break;
+      }
+    }
+  }
+  LOG_DEBUGF("  %llu pushes from %u call sites:", s->pushes, s->siteCt);
+  for (u32 j = 0; j < ARENA__REPORT_SITES && NULL != top[j]; j++) {
+    LOG_DEBUGF(
+        "    %12llu B %8u pushes  %s:%u",
+        top[j]->bytes,
+        top[j]->pushes,
+        top[j]->file,
+        top[j]->line);
+  }
+  if (s->dropped > 0) {
+    LOG_DEBUGF("    %12llu B  (untracked; raise ARENA__MAX_SITES)", s->dropped);
+  }
+
+  // used-at-reset history; a steadily positive trend is runaway growth
+  u32 n = s->resets < ARENA__HISTORY_CT ? s->resets : ARENA__HISTORY_CT;
+  if (0 == n) {
+    return;
+  }
+  u32 first = s->resets - n;
+  u64 min = UINT64_MAX, max = 0, sum = 0, older = 0, newer = 0;
+  for (u32 i = 0; i < n; i++) {
+    u64 v = s->history[(first + i) % ARENA__HISTORY_CT];
+    min = v < min ? v : min;
+    max = v > max ? v : max;
+    sum += v;
+    if (i < n / 2) {
+      older += v;
+    } else if (i >= n - n / 2) {
+      newer += v;
+    }
+  }
+  s64 trend = n >= 2 ? ((s64)newer - (s64)older) / (s64)(n / 2) / (s64)(n - n / 2) : 0;
+  LOG_DEBUGF(
+      "  last %u of %u resets: min %llu KB  avg %llu KB  max %llu KB  trend %+lld B/reset",
+      n,
+      s->resets,
+      min / 1024,
+      sum / n / 1024,
+      max / 1024,
+      trend);
 }
+#endif
\ No newline at end of file
@@ -30,17 +30,22 @@
 // manages the CRUD for the ByteBuffer data struct
 
 // Reset buffer to initial state and clear data
+// clears everything ever written: [data, max(write, dirty)), not just what is currently readable
 void SZ_reset(ByteBuffer* buf) {
+  u8* to = buf->dirty > buf->write ? buf->dirty : buf->write;
+  memset(buf->data, 0, to - buf->data);
   buf->read = buf->data;
   buf->write = buf->data;
-  memset(buf->data, 0, buf->end - buf->data);
+  buf->dirty = buf->data;
 }
 
 // Allocate buffer from arena with specified size
 void SZ_alloc(Arena* arena, ByteBuffer* buf, u32 sz) {
-  buf->data = (u8*)Arena__push(arena, sz);
+  buf->data = (u8*)Arena__pushZ(arena, sz);
   buf->end = buf->data + sz;
-  SZ_reset(buf);
+  buf->read = buf->data;
+  buf->write = buf->data;
+  buf->dirty = buf->data;
 }
 
 // Wrap existing data in buffer
@@ -48,20 +53,22 @@ void SZ_wrap(ByteBuffer* buf, u8* data, u32 len, u32 sz) {
   buf->data = buf->read = data;
   buf->write = buf->read + len;
   buf->end = buf->read + sz;
+  buf->dirty = buf->end;  // caller's bytes past len are unknown
 }
 
 // Defragment buffer by moving data to start
 void SZ_defrag(ByteBuffer* buf) {
   u32 len = buf->write - buf->read;
   if (0 == len) {
-    buf->read = buf->write = buf->data;
+    SZ_reset(buf);
     return;
   }
 
   u32 gap = buf->read - buf->data;
   if (0 == gap)
     return;
-  memcpy(buf->data, buf->read, len);
+  memmove(buf->data, buf->read, len);  // ranges overlap when len > gap
+  memset(buf->data + len, 0, gap);  // vacated tail; bytes past write stay zero
   buf->read = buf->data;
   buf->write = buf->read + len;
 }
@@ -0,0 +1,126 @@
+#pragma once
+
+#include "../unity.h"  // IWYU pragma: keep
+
+// inspired by:
+// - [Linux kernel - include/linux/list.h](https://github.com/torvalds/linux/blob/master/include/linux/list.h)
+
+// @class DList
+// Function | Purpose
+// --- | ---
+// DList__init(head) | Make an empty list (or reset a link to unlinked)
+// DList__empty(head) | Is the list empty?
+// DList__linked(link) | Is this element currently in a list?
+// DList__pushFront(head, link) | Insert element at the front
+// DList__pushBack(head, link) | Insert element at the back
+// DList__insertBefore(pos, link) | Insert element before pos (keeps buckets sorted)
+// DList__remove(link) | Unlink element; O(1), safe to call twice
+// DList__first(head) | First link, or NULL if empty
+// DList__popFront(head) | Unlink + return first link, or NULL
+// DList__popBack(head) | Unlink + return last link, or NULL
+// DList__splice(dst, src) | Move every element of src to the back of dst; O(1)
+// DList__len(head) | Count elements (O(n))
+// DList__entry(link, T, member) | Element that contains link
+// DLIST__EACH(link, head) | for-loop over links; the current link may be removed
+
+// usage:
+//   typedef struct { Socket* sock; DList active; } Conn;
+//   DList actives;
+//   DList__init(&actives);
+//   DList__pushBack(&actives, &conn->active);
+//   DList__remove(&conn->active);  // no search; conn knows its own neighbours
+//
+//   DLIST__EACH(link, &actives) {
+//     Conn* c = DList__entry(link, Conn, active);
+//   }
+
+#define DList__entry(link, T, member) ((T*)((u8*)(link) - offsetof(T, member)))
+#define DLIST__EACH(link, head)                                               \
+  for (DList *link = (head)->next, *link##_next = link->next; link != (head); \
+       link = link##_next, link##_next = link->next)
+
+// Make an empty list (or reset a link to unlinked)
+static inline void DList__init(DList* head) {
+  head->next = head->prev = head;
+}
+
+// Is the list empty?
+static inline bool DList__empty(const DList* head) {
+  return head->next == head;
+}
+
+// Is this element currently in a list?
+static inline bool DList__linked(const DList* link) {
+  return NULL != link->next && link->next != link;
+}
+
+// Insert element before pos (keeps buckets sorted)
+static inline void DList__insertBefore(DList* pos, DList* link) {
+  link->next = pos;
+  link->prev = pos->prev;
+  pos->prev->next = link;
+  pos->prev = link;
+}
+
+// Insert element at the front
+static inline void DList__pushFront(DList* head, DList* link) {
+  DList__insertBefore(head->next, link);
+}
+
+// Insert element at the back
+static inline void DList__pushBack(DList* head, DList* link) {
+  DList__insertBefore(head, link);
+}
+
+// Unlink element; O(1), safe to call twice
+static inline void DList__remove(DList* link) {
+  if (DList__linked(link)) {
+    link->prev->next = link->next;
+    link->next->prev = link->prev;
+  }
+  DList__init(link);
+}
+
+// First link, or NULL if empty
+static inline DList* DList__first(DList* head) {
+  return DList__empty(head) ? NULL : head->next;
+}
+
+// Unlink + return first link, or NULL
+static inline DList* DList__popFront(DList* head) {
+  DList* link = DList__first(head);
+  if (NULL != link) {
+    DList__remove(link);
+  }
+  return link;
+}
+
+// Unlink + return last link, or NULL
+static inline DList* DList__popBack(DList* head) {
+  DList* link = DList__empty(head) ? NULL : head->prev;
+  if (NULL != link) {
+    DList__remove(link);
+  }
+  return link;
+}
+
+// Move every element of src to the back of dst; O(1)
+static inline void DList__splice(DList* dst, DList* src) {
+  if (DList__empty(src)) {
+    return;
+  }
+  src->next->prev = dst->prev;
+  dst->prev->next = src->next;
+  src->prev->next = dst;
+  dst->prev = src->prev;
+  DList__init(src);
+}
+
+// Count elements (O(n))
+static inline u32 DList__len(DList* head) {
+  u32 n = 0;
+  DLIST__EACH(link, head) {
+    n++;
+  }
+  return n;
+}
\ No newline at end of file
@@ -0,0 +1,261 @@
+#pragma once
+
+#include "../unity.h"  // IWYU pragma: keep
+
+// inspired by:
+// - [2019 Michele Caini - ECS back and forth, part 2: where are my entities?](https://skypjack.github.io/2019-03-07-ecs-baf-part-2/)
+// - [Mike Acton - Data-Oriented Design and C++ (CppCon 2014)](https://www.youtube.com/watch?v=rX0ItVEVjHc)
+
+// @class Ecs
+// Function | Purpose
+// --- | ---
+// Ecs__init(ecs, arena, cap) | Empty store for up to cap live entities
+// Ecs__component(ecs, fieldSz, fieldCt, cap) | Register a component type; returns its id
+// Ecs__create(ecs) | New entity with no components (gen 0 if full)
+// Ecs__alive(ecs, e) | true if e has not been destroyed
+// Ecs__handle(ecs, idx) | Handle for a live entity idx (e.g. join->entity)
+// Ecs__destroy(ecs, e) | Remove all components and free the entity
+// Ecs__add(ecs, e, c) | Give e component c (zeroed); returns its row
+// Ecs__row(ecs, e, c) | Row of e in component c (ECS__NONE if absent)
+// Ecs__remove(ecs, e, c) | Take component c away from e
+// Ecs__join(ecs, mask) | Cursor over entities having every component in mask
+// EcsJoin__next(j) | Advance cursor; false when done
+// Ecs__parallel(ecs, mask, grain, fn, userdata) | Run a system over a join, split across workers
+
+// usage:
+//   enum { POS, VEL };
+//   enum { X, Y };  // field (column) indices
+//   u16 xy[] = {sizeof(f32), sizeof(f32)};
+//   Ecs__init(&_G->ecs, _G->arena, 64 * 1024);
+//   Ecs__component(&_G->ecs, xy, 2, 0);  // POS
+//   Ecs__component(&_G->ecs, xy, 2, 0);  // VEL
+//
+//   EcsEntity e = Ecs__create(&_G->ecs);
+//   u32 row = Ecs__add(&_G->ecs, e, VEL);
+//   ECS__COL(&_G->ecs, VEL, X, f32)[row] = 1.0f;
+//
+//   void Move__system(EcsJoin* j, ParallelTask* t) {
+//     while (EcsJoin__next(j)) ECS__FIELD(j, POS, X, f32) += ECS__FIELD(j, VEL, X, f32);
+//   }
+//   Ecs__parallel(&_G->ecs, ECS__BIT(POS) | ECS__BIT(VEL), 0, Move__system, NULL);
+
+// NOTE: add/remove/create/destroy reorder rows; don't call them from inside a join.
+// collect changes (e.g. on task->scratch) and apply them after the system returns
+
+// typed column of component c, field f; index with a row
+#define ECS__COL(ecs, c, f, T) ((T*)(ecs)->pools[c].cols[f])
+// field f of component c for the join's current entity (lvalue)
+#define ECS__FIELD(j, c, f, T) (ECS__COL((j)->ecs, c, f, T)[(j)->rows[c]])
+
+// Empty store for up to cap live entities
+bool Ecs__init(Ecs* ecs, Arena* arena, u32 cap) {
+  memset(ecs, 0, sizeof(Ecs));
+  ecs->arena = arena;
+  ecs->cap = cap;
+  ecs->freeHead = ECS__NONE;
+  ecs->masks = Arena__pushArrayZ(arena, EcsMask, cap);
+  ecs->gens = Arena__pushArray(arena, u32, cap);
+  ecs->next = Arena__pushArray(arena, u32, cap);
+  return NULL != ecs->masks && NULL != ecs->gens && NULL != ecs->next;
+}
+
+// Register a component type; returns its id
+// fieldSz[i] = bytes per value of field i; each field is its own dense column (SoA)
+// cap = max entities with this component (0 = entity cap)
+// @returns ECS__NONE if out of ids or arena space
+u32 Ecs__component(Ecs* ecs, const u16* fieldSz, u32 fieldCt, u32 cap) {
+  ASSERT_CONTEXT(
+      fieldCt <= ECS__MAX_FIELDS,
+      "Component has %u fields, max %u",
+      fieldCt,
+      ECS__MAX_FIELDS);
+  if (ecs->componentCt == ECS__MAX_COMPONENTS) {
+    return ECS__NONE;
+  }
+  EcsPool* pool = &ecs->pools[ecs->componentCt];
+  pool->cap = 0 == cap ? ecs->cap : cap;
+  pool->fieldCt = fieldCt;
+  pool->sparse = Arena__pushArray(ecs->arena, u32, ecs->cap);
+  pool->dense = Arena__pushArray(ecs->arena, u32, pool->cap);
+  if (NULL == pool->sparse || NULL == pool->dense) {
+    return ECS__NONE;
+  }
+  memset(pool->sparse, 0xff, (u64)ecs->cap * sizeof(u32));  // ECS__NONE
+  for (u32 f = 0; f < fieldCt; f++) {
+    pool->fieldSz[f] = fieldSz[f];
+    pool->cols[f] = (u8*)Arena__pushCacheline(ecs->arena, (u64)pool->cap * fieldSz[f]);
+    if (NULL == pool->cols[f]) {
+      return ECS__NONE;
+    }
+  }
+  return ecs->componentCt++;
+}
+
+// New entity with no components (gen 0 if full)
+EcsEntity Ecs__create(Ecs* ecs) {
+  u32 idx;
+  if (ECS__NONE != ecs->freeHead) {
+    idx = ecs->freeHead;
+    ecs->freeHead = ecs->next[idx];
+  } else if (ecs->slotCt < ecs->cap) {
+    idx = ecs->slotCt++;
+    ecs->gens[idx] = 1;
+  } else {
+    return (EcsEntity){0};
+  }
+  ecs->next[idx] = ECS__NONE;  // marks live
+  ecs->len++;
+  return (EcsEntity){.idx = idx, .gen = ecs->gens[idx]};
+}
+
+// true if e has not been destroyed
+bool Ecs__alive(Ecs* ecs, EcsEntity e) {
+  return e.idx < ecs->slotCt && 0 != e.gen && e.gen == ecs->gens[e.idx] &&
+         ECS__NONE == ecs->next[e.idx];
+}
+
+// Handle for a live entity idx (e.g. join->entity)
+EcsEntity Ecs__handle(Ecs* ecs, u32 idx) {
+  return (EcsEntity){.idx = idx, .gen = ecs->gens[idx]};
+}
+
+// swap-remove idx's row from pool c; the last row moves into the hole
+static void _Ecs__unlink(Ecs* ecs, u32 idx, u32 c) {
+  EcsPool* pool = &ecs->pools[c];
+  u32 row = pool->sparse[idx];
+  u32 last = --pool->len;
+  if (row != last) {
+    u32 moved = pool->dense[last];
+    for (u32 f = 0; f < pool->fieldCt; f++) {
+      u32 sz = pool->fieldSz[f];
+      memcpy(pool->cols[f] + (u64)row * sz, pool->cols[f] + (u64)last * sz, sz);
+    }
+    pool->dense[row] = moved;
+    pool->sparse[moved] = row;
+  }
+  pool->sparse[idx] = ECS__NONE;
+  ecs->masks[idx] &= ~ECS__BIT(c);
+}
+
+// Remove all components and free the entity
+// @returns false if e was not alive
+bool Ecs__destroy(Ecs* ecs, EcsEntity e) {
+  if (!Ecs__alive(ecs, e)) {
+    return false;
+  }
+  for (EcsMask m = ecs->masks[e.idx]; 0 != m; m &= m - 1) {
+    _Ecs__unlink(ecs, e.idx, (u32)__builtin_ctz(m));
+  }
+  ecs->gens[e.idx] = 0 == ecs->gens[e.idx] + 1 ? 1 : ecs->gens[e.idx] + 1;  // 0 stays invalid
+  ecs->next[e.idx] = ecs->freeHead;
+  ecs->freeHead = e.idx;
+  ecs->len--;
+  return true;
+}
+
+// Give e component c (zeroed); returns its row
+// @returns the existing row if e already has c; ECS__NONE if e is dead or the pool is full
+u32 Ecs__add(Ecs* ecs, EcsEntity e, u32 c) {
+  if (c >= ecs->componentCt || !Ecs__alive(ecs, e)) {
+    return ECS__NONE;
+  }
+  EcsPool* pool = &ecs->pools[c];
+  if (ECS__NONE != pool->sparse[e.idx]) {
+    return pool->sparse[e.idx];
+  }
+  if (pool->len == pool->cap) {
+    return ECS__NONE;
+  }
+  u32 row = pool->len++;
+  pool->dense[row] = e.idx;
+  pool->sparse[e.idx] = row;
+  for (u32 f = 0; f < pool->fieldCt; f++) {
+    memset(pool->cols[f] + (u64)row * pool->fieldSz[f], 0, pool->fieldSz[f]);
+  }
+  ecs->masks[e.idx] |= ECS__BIT(c);
+  return row;
+}
+
+// Row of e in component c (ECS__NONE if absent)
+// rows move when other entities lose c; don't hold one across add/remove/destroy
+u32 Ecs__row(Ecs* ecs, EcsEntity e, u32 c) {
+  if (c >= ecs->componentCt || !Ecs__alive(ecs, e)) {
+    return ECS__NONE;
+  }
+  return ecs->pools[c].sparse[e.idx];
+}
+
+// Take component c away from e
+// @returns false if e did not have it
+bool Ecs__remove(Ecs* ecs, EcsEntity e, u32 c) {
+  if (ECS__NONE == Ecs__row(ecs, e, c)) {
+    return false;
+  }
+  _Ecs__unlink(ecs, e.idx, c);
+  return true;
+}
+
+// Cursor over entities having every component in mask
+// scans the smallest pool in mask, so cost follows the rarest component
+EcsJoin Ecs__join(Ecs* ecs, EcsMask mask) {
+  EcsJoin j = {.ecs = ecs, .mask = mask};
+  u32 best = UINT32_MAX;
+  for (EcsMask m = mask; 0 != m; m &= m - 1) {
+    u32 c = (u32)__builtin_ctz(m);
+    ASSERT_CONTEXT(c < ecs->componentCt, "Join on unregistered component %u", c);
+    if (ecs->pools[c].len < best) {
+      best = ecs->pools[c].len;
+      j.lead = c;
+    }
+  }
+  j.end = 0 != mask ? best : 0;
+  return j;
+}
+
+// Advance cursor; false when done
+bool EcsJoin__next(EcsJoin* j) {
+  Ecs* ecs = j->ecs;
+  const u32* dense = ecs->pools[j->lead].dense;
+  while (j->i < j->end) {
+    u32 e = dense[j->i++];
+    if ((ecs->masks[e] & j->mask) != j->mask) {
+      continue;
+    }
+    j->entity = e;
+    for (EcsMask m = j->mask; 0 != m; m &= m - 1) {
+      u32 c = (u32)__builtin_ctz(m);
+      j->rows[c] = ecs->pools[c].sparse[e];
+    }
+    return true;
+  }
+  return false;
+}
+
+typedef struct {
+  EcsJoin join;
+  Ecs__system_t fn;
+  void* userdata;
+} _EcsJob;
+
+// one chunk of lead rows -> one bounded join
+static void _Ecs__task(ParallelTask* task) {
+  _EcsJob* job = (_EcsJob*)task->userdata;
+  EcsJoin j = job->join;
+  j.i = task->begin;
+  j.end = task->end;
+  task->userdata = job->userdata;
+  job->fn(&j, task);
+}
+
+// Run a system over a join, split across workers
+// each task gets its own cursor over a slice of the lead pool's rows
+// grain = lead rows per chunk (0 = default)
+void Ecs__parallel(Ecs* ecs, EcsMask mask, u32 grain, Ecs__system_t fn, void* userdata) {
+  _EcsJob job = {.join = Ecs__join(ecs, mask), .fn = fn, .userdata = userdata};
+  ARange2 range = {
+      .ct = job.join.end,
+      .stride = sizeof(u32),
+      .ptr = ecs->pools[job.join.lead].dense,
+  };
+  Parallel__for(range, grain, _Ecs__task, &job);
+}
\ No newline at end of file
@@ -0,0 +1,387 @@
+#pragma once
+
+#include "../unity.h"  // IWYU pragma: keep
+
+// inspired by:
+// - [2018 Boost.Context - fcontext_t (x86_64 SysV)](https://github.com/boostorg/context/blob/develop/src/asm/jump_x86_64_sysv_elf_gas.S)
+// - [2015 Christian Gyrling - Parallelizing the Naughty Dog Engine Using Fibers](https://www.gdcvault.com/play/1022186)
+
+// @class FiberSched
+// Function | Purpose
+// --- | ---
+// FiberSched__init(sched, arena, cap, stackSz) | Allocate fiber pool (arena) + guarded stacks
+// FiberSched__spawn(sched, fn, userdata) | Start a fiber (NULL when pool exhausted)
+// FiberSched__poll(sched) | Resume fibers whose sockets/timers are ready (call once per loop)
+// FiberSched__free(sched) | Release scheduler stacks + OS resources
+
+// @class Fiber
+// Function | Purpose
+// --- | ---
+// Fiber__current() | Fiber running on this thread (NULL on event loop)
+// Fiber__yield() | Reschedule self behind other ready fibers
+// Fiber__sleep(ms) | Suspend self for at least ms
+// Fiber__read(sock, buf, len) | Await + read up to len bytes; -1 on close/error
+// Fiber__write(sock, buf, len) | Await + write all len bytes; -1 on close/error
+
+// usage:
+//   void Session__run(Fiber* f, void* userdata) {
+//     Socket* sock = (Socket*)userdata;
+//     u8 buf[512];
+//     s32 n = Fiber__read(sock, buf, sizeof(buf));  // handshake
+//     ...
+//     Fiber__write(sock, reply, len);
+//   }
+//   // in onsockaccept: FiberSched__spawn(&sched, Session__run, accepted);
+//   // in main loop:    FiberSched__poll(&sched);
+
+// NOTE: Fiber__read() bypasses onsockrecv, so fiber-driven input is not in Replay logs
+
+static __thread Fiber* _Fiber__current = NULL;
+
+// ---
+// Context switch
+
+// save callee-saved state of `from` on its stack, restore `to`
+void _Fiber__switch(FiberCtx* from, FiberCtx* to) __asm__("_Fiber__switch");
+
+#if defined(__x86_64__) && !defined(_WIN32)
+// System V AMD64: rbx, rbp, r12-r15, mxcsr, x87 cw are callee-saved
+// clang-format off
+__asm__(
+    ".text\n"
+    ".p2align 4\n"
+    ".globl _Fiber__switch\n"
+    "_Fiber__switch:\n"
+    "  pushq %rbp\n"
+    "  pushq %rbx\n"
+    "  pushq %r12\n"
+    "  pushq %r13\n"
+    "  pushq %r14\n"
+    "  pushq %r15\n"
+    "  subq $8, %rsp\n"
+    "  stmxcsr (%rsp)\n"
+    "  fnstcw 4(%rsp)\n"
+    "  movq %rsp, (%rdi)\n"  // from->sp
+    "  movq (%rsi), %rsp\n"  // to->sp
+    "  ldmxcsr (%rsp)\n"
+    "  fldcw 4(%rsp)\n"
+    "  addq $8, %rsp\n"
+    "  popq %r15\n"
+    "  popq %r14\n"
+    "  popq %r13\n"
+    "  popq %r12\n"
+    "  popq %rbx\n"
+    "  popq %rbp\n"
+    "  ret\n");
+// clang-format on
+#else
+void _Fiber__switch(FiberCtx* from, FiberCtx* to) {
+  ASSERT_CONTEXT(false, "Fibers are only implemented for x86-64 System V");
+}
+#endif
+
+// first frame of every fiber; never returns
+static void _Fiber__main(void) {
+  Fiber* f = _Fiber__current;
+  f->fn(f, f->userdata);
+  f->state = FIBER_DONE;
+  _Fiber__switch(&f->ctx, &f->sched->ctx);
+}
+
+// lay out a stack so the first switch "returns" into _Fiber__main()
+static void _Fiber__prepare(Fiber* f, u32 stackSz) {
+  u64* top = (u64*)(((uintptr_t)(f->stack + stackSz)) & ~(uintptr_t)15);
+  *--top = 0;  // fake return address of _Fiber__main (keeps rsp % 16 == 8 at entry)
+  *--top = (u64)(uintptr_t)_Fiber__main;  // ret target
+  for (u32 i = 0; i < 6; i++) {
+    *--top = 0;  // rbp, rbx, r12, r13, r14, r15
+  }
+  *--top = 0x037F00001F80ULL;  // x87 cw (hi) | mxcsr (lo); default FPU state
+  f->ctx.sp = top;
+}
+
+// ---
+// Scheduler
+
+// bytes of the stack mapping: one guard page + stack per fiber
+static inline u64 _FiberSched__stacksSz(FiberSched* sched) {
+  return (u64)(FIBER__GUARD_SZ + sched->stackSz) * sched->cap;
+}
+
+// Release scheduler stacks + OS resources
+void FiberSched__free(FiberSched* sched) {
+#ifdef __linux__
+  if (sched->epollFd >= 0) {
+    close(sched->epollFd);
+  }
+  if (NULL != sched->stacks) {
+    munmap(sched->stacks, _FiberSched__stacksSz(sched));
+  }
+#endif
+  sched->epollFd = -1;
+  sched->stacks = NULL;
+  sched->free = NULL;
+}
+
+// Allocate fiber pool (arena) + guarded stacks
+// stacks get their own mapping, each above a PROT_NONE page, so an overflowing handler
+// faults instead of silently overwriting the neighbouring fiber's saved context
+// stackSz is rounded up to whole pages (0 = FIBER__STACK_SZ)
+// NOTE: each guard splits the mapping, ~2 VMAs per fiber; past ~32k fibers raise
+//       vm.max_map_count (default 65530) or mprotect() fails and init returns false
+bool FiberSched__init(FiberSched* sched, Arena* arena, u32 cap, u32 stackSz) {
+  memset(sched, 0, sizeof(FiberSched));
+  sched->epollFd = -1;
+  sched->cap = cap;
+  sched->stackSz = 0 == stackSz ? FIBER__STACK_SZ : stackSz;
+  sched->stackSz = (sched->stackSz + ARENA__PAGE_SZ - 1) & ~(u32)(ARENA__PAGE_SZ - 1);
+  sched->fibers = Arena__pushArray(arena, Fiber, cap);
+  if (NULL == sched->fibers) {
+    return false;
+  }
+#ifdef __linux__
+  void* p = mmap(
+      NULL,
+      _FiberSched__stacksSz(sched),
+      PROT_READ | PROT_WRITE,
+      MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE,
+      -1,
+      0);
+  if (MAP_FAILED == p) {
+    return false;
+  }
+  sched->stacks = (u8*)p;
+  for (u32 i = 0; i < cap; i++) {
+    u8* guard = sched->stacks + (u64)i * (FIBER__GUARD_SZ + sched->stackSz);
+    if (0 != mprotect(guard, FIBER__GUARD_SZ, PROT_NONE)) {
+      FiberSched__free(sched);
+      return false;
+    }
+  }
+#endif
+  for (u32 i = cap; i > 0; i--) {
+    Fiber* f = &sched->fibers[i - 1];
+    f->state = FIBER_FREE;
+    f->stack = sched->stacks + (u64)(i - 1) * (FIBER__GUARD_SZ + sched->stackSz) +
+               FIBER__GUARD_SZ;
+    f->sched = sched;
+    f->next = sched->free;
+    sched->free = f;
+  }
+#ifdef __linux__
+  sched->epollFd = epoll_create1(0);
+  if (sched->epollFd < 0) {
+    FiberSched__free(sched);
+    return false;
+  }
+  return true;
+#else
+  return false;  // no epoll; fibers are Linux-only
+#endif
+}
+
+static void _FiberSched__ready(FiberSched* sched, Fiber* f) {
+  f->state = FIBER_READY;
+  f->next = NULL;
+  if (NULL == sched->readyTail) {
+    sched->readyHead = sched->readyTail = f;
+  } else {
+    sched->readyTail->next = f;
+    sched->readyTail = f;
+  }
+}
+
+// Start a fiber (NULL when pool exhausted)
+Fiber* FiberSched__spawn(FiberSched* sched, Fiber__fn_t fn, void* userdata) {
+  Fiber* f = sched->free;
+  if (NULL == f) {
+    return NULL;
+  }
+  sched->free = f->next;
+  f->fn = fn;
+  f->userdata = userdata;
+  f->polledFd = -1;
+  f->wakeAt = 0;
+  _Fiber__prepare(f, sched->stackSz);
+  sched->live++;
+  _FiberSched__ready(sched, f);
+  return f;
+}
+
+// return a finished fiber (and its stack) to the pool
+static void _FiberSched__reclaim(FiberSched* sched, Fiber* f) {
+#ifdef __linux__
+  if (f->polledFd >= 0) {
+    epoll_ctl(sched->epollFd, EPOLL_CTL_DEL, (int)f->polledFd, NULL);  // ok if fd closed
+  }
+#endif
+  f->state = FIBER_FREE;
+  f->next = sched->free;
+  sched->free = f;
+  sched->live--;
+}
+
+// move fibers with ready sockets or expired timers onto the run queue
+static void _FiberSched__wake(FiberSched* sched) {
+#ifdef __linux__
+  struct epoll_event events[64];
+  for (u32 batch = 0; batch < 1024; batch++) {
+    s32 n = epoll_wait(sched->epollFd, events, ARRAYSIZE(events), 0);
+    for (s32 i = 0; i < n; i++) {
+      Fiber* f = (Fiber*)events[i].data.ptr;
+      if (FIBER_WAIT_IO == f->state) {
+        _FiberSched__ready(sched, f);
+      }
+    }
+    if (n < (s32)ARRAYSIZE(events)) {
+      break;
+    }
+  }
+#endif
+
+  u64 now = Time__now();
+  Fiber** link = &sched->sleeping;
+  for (u32 i = 0; i < sched->cap && NULL != *link; i++) {
+    Fiber* f = *link;
+    if (f->wakeAt <= now) {
+      *link = f->next;
+      _FiberSched__ready(sched, f);
+    } else {
+      link = &f->next;
+    }
+  }
+}
+
+// Resume fibers whose sockets/timers are ready (call once per loop)
+// @returns count of fibers still alive
+u32 FiberSched__poll(FiberSched* sched) {
+  _FiberSched__wake(sched);
+
+  // only run what is ready now; fibers that yield wait for the next poll
+  Fiber* tail = sched->readyTail;
+  for (u32 i = 0; i < sched->cap && NULL != sched->readyHead; i++) {
+    Fiber* f = sched->readyHead;
+    sched->readyHead = f->next;
+    if (NULL == sched->readyHead) {
+      sched->readyTail = NULL;
+    }
+
+    f->state = FIBER_RUNNING;
+    _Fiber__current = f;
+    _Fiber__switch(&sched->ctx, &f->ctx);
+    _Fiber__current = NULL;
+
+    if (FIBER_DONE == f->state) {
+      _FiberSched__reclaim(sched, f);
+    }
+    if (f == tail) {
+      break;
+    }
+  }
+  return sched->live;
+}
+
+// ---
+// Fiber (call only from inside a fiber)
+
+// Fiber running on this thread (NULL on event loop)
+Fiber* Fiber__current(void) {
+  return _Fiber__current;
+}
+
+// hand control back to the event loop
+static void _Fiber__suspend(Fiber* f) {
+  _Fiber__switch(&f->ctx, &f->sched->ctx);
+}
+
+// Reschedule self behind other ready fibers
+void Fiber__yield(void) {
+  Fiber* f = _Fiber__current;
+  ASSERT_CONTEXT(f, "Fiber__yield() called outside a fiber");
+  _FiberSched__ready(f->sched, f);
+  _Fiber__suspend(f);
+}
+
+// Suspend self for at least ms
+void Fiber__sleep(u32 ms) {
+  Fiber* f = _Fiber__current;
+  ASSERT_CONTEXT(f, "Fiber__sleep() called outside a fiber");
+  f->state = FIBER_SLEEP;
+  f->wakeAt = Time__now() + ms;
+  f->next = f->sched->sleeping;
+  f->sched->sleeping = f;
+  _Fiber__suspend(f);
+}
+
+// park until fd is readable/writable (one-shot; re-armed per await)
+static void _Fiber__awaitFd(Fiber* f, s64 fd, u32 events) {
+#ifdef __linux__
+  struct epoll_event ev = {.events = events | EPOLLONESHOT, .data = {.ptr = f}};
+  if (fd != f->polledFd) {
+    if (f->polledFd >= 0) {
+      epoll_ctl(f->sched->epollFd, EPOLL_CTL_DEL, (int)f->polledFd, NULL);
+    }
+    epoll_ctl(f->sched->epollFd, EPOLL_CTL_ADD, (int)fd, &ev);
+    f->polledFd = fd;
+  } else {
+    epoll_ctl(f->sched->epollFd, EPOLL_CTL_MOD, (int)fd, &ev);
+  }
+#endif
+  f->state = FIBER_WAIT_IO;
+  _Fiber__suspend(f);
+}
+
+// drop the epoll registration before closing, so a reused fd number is never touched
+// (reclaim's EPOLL_CTL_DEL, or awaitFd skipping ADD for a "same" fd)
+static void _Fiber__close(Fiber* f, Socket* sock) {
+#ifdef __linux__
+  if (f->polledFd >= 0 && (u64)f->polledFd == sock->_nix_socket) {
+    epoll_ctl(f->sched->epollFd, EPOLL_CTL_DEL, (int)f->polledFd, NULL);
+    f->polledFd = -1;
+  }
+#endif
+  Sock__close(sock);
+}
+
+// Await + read up to len bytes; -1 on close/error
+s32 Fiber__read(Socket* sock, u8* buf, u32 len) {
+  Fiber* f = _Fiber__current;
+  ASSERT_CONTEXT(f, "Fiber__read() called outside a fiber");
+#ifdef __linux__
+  while (SOCKET_CLOSED != sock->state) {
+    s32 r = (s32)read(sock->_nix_socket, buf, len);
+    if (r > 0) {
+      return r;
+    }
+    if (0 == r || (errno != EAGAIN && errno != EWOULDBLOCK)) {
+      _Fiber__close(f, sock);  // FIN or error
+      return -1;
+    }
+    _Fiber__awaitFd(f, sock->_nix_socket, EPOLLIN | EPOLLRDHUP);
+  }
+#endif
+  return -1;
+}
+
+// Await + write all len bytes; -1 on close/error
+s32 Fiber__write(Socket* sock, const u8* buf, u32 len) {
+  Fiber* f = _Fiber__current;
+  ASSERT_CONTEXT(f, "Fiber__write() called outside a fiber");
+#ifdef __linux__
+  u32 sent = 0;
+  while (sent < len && SOCKET_CLOSED != sock->state) {
+    s32 r = (s32)send(sock->_nix_socket, buf + sent, len - sent, MSG_NOSIGNAL);
+    if (r > 0) {
+      sent += r;
+      continue;
+    }
+    if (errno != EAGAIN && errno != EWOULDBLOCK) {
+      _Fiber__close(f, sock);
+      return -1;
+    }
+    _Fiber__awaitFd(f, sock->_nix_socket, EPOLLOUT);
+  }
+  return sent == len ? (s32)len : -1;
+#endif
+  return -1;
+}
\ No newline at end of file
@@ -0,0 +1,256 @@
+#pragma once
+
+#include "../unity.h"  // IWYU pragma: keep
+
+// inspired by:
+// - [2003 Teschner et al. - Optimized Spatial Hashing for Collision Detection of Deformable Objects](https://matthias-research.github.io/pages/publications/tetraederCollision.pdf)
+// - [Valve - Source Multiplayer Networking: entity PVS](https://developer.valvesoftware.com/wiki/Source_Multiplayer_Networking)
+
+// @class Grid
+// Function | Purpose
+// --- | ---
+// Grid__init(g, arena, cap, bucketCt, cellSz) | Empty grid for item ids 0..cap-1
+// Grid__insert(g, id, x, y) | Add item, or move it if already present
+// Grid__move(g, id, x, y) | Update position; relinks only when the cell changes
+// Grid__remove(g, id) | Take item out of the grid
+// Grid__queryAabb(g, minX, minY, maxX, maxY, out, max) | Items inside the box
+// Grid__queryRadius(g, x, y, r, out, max) | Items within r of (x, y)
+
+// @class GridView
+// Function | Purpose
+// --- | ---
+// GridView__init(v, arena, cap) | Empty visible set for item ids 0..cap-1
+// GridView__diff(v, ids, ct, arena, diff) | Set visible ids; report entered/left/stayed
+
+// usage:
+//   Grid__init(&world->grid, _G->arena, MAX_ENTITIES, 4096, 32.0f);  // cell ~ query radius
+//   Grid__move(&world->grid, e.idx, x, y);  // each tick, per entity that moved
+//
+//   // snapshot building, per client
+//   u32* near = Arena__pushArray(_G->frameArena, u32, world->grid.len);
+//   u32 ct = Grid__queryRadius(&world->grid, cl->x, cl->y, VIEW_RADIUS, near, world->grid.len);
+//   GridDiff d;
+//   GridView__diff(&cl->view, near, ct, _G->frameArena, &d);
+//   // d.entered -> full state, d.stayed -> delta, d.left -> despawn
+
+// cell coordinate; floor without libm
+static inline s32 _Grid__cell(Grid* g, f32 v) {
+  f32 f = v * g->invCellSz;
+  s32 c = (s32)f;
+  return (f32)c > f ? c - 1 : c;
+}
+
+static inline u32 _Grid__hash(Grid* g, s32 cx, s32 cy) {
+  return ((u32)cx * 73856093u ^ (u32)cy * 19349663u) & g->bucketMask;
+}
+
+// Empty grid for item ids 0..cap-1
+// bucketCt rounds up to a power of 2; ~len/2..len buckets keeps chains short
+bool Grid__init(Grid* g, Arena* arena, u32 cap, u32 bucketCt, f32 cellSz) {
+  memset(g, 0, sizeof(Grid));
+  u32 n = 1;
+  while (n < bucketCt) {
+    n <<= 1;
+  }
+  g->bucketMask = n - 1;
+  g->cap = cap;
+  g->cellSz = cellSz;
+  g->invCellSz = 1.0f / cellSz;
+  g->heads = Arena__pushArray(arena, u32, n);
+  g->next = Arena__pushArray(arena, u32, cap);
+  g->prev = Arena__pushArray(arena, u32, cap);
+  g->bucket = Arena__pushArray(arena, u32, cap);
+  g->cx = Arena__pushArray(arena, s32, cap);
+  g->cy = Arena__pushArray(arena, s32, cap);
+  g->x = Arena__pushArray(arena, f32, cap);
+  g->y = Arena__pushArray(arena, f32, cap);
+  if (NULL == g->heads || NULL == g->next || NULL == g->prev || NULL == g->bucket ||
+      NULL == g->cx || NULL == g->cy || NULL == g->x || NULL == g->y) {
+    return false;
+  }
+  memset(g->heads, 0xff, (u64)n * sizeof(u32));  // GRID__NONE
+  memset(g->bucket, 0xff, (u64)cap * sizeof(u32));
+  return true;
+}
+
+static void _Grid__link(Grid* g, u32 id, u32 b) {
+  g->bucket[id] = b;
+  g->prev[id] = GRID__NONE;
+  g->next[id] = g->heads[b];
+  if (GRID__NONE != g->heads[b]) {
+    g->prev[g->heads[b]] = id;
+  }
+  g->heads[b] = id;
+}
+
+static void _Grid__unlink(Grid* g, u32 id) {
+  u32 b = g->bucket[id];
+  if (GRID__NONE != g->prev[id]) {
+    g->next[g->prev[id]] = g->next[id];
+  } else {
+    g->heads[b] = g->next[id];
+  }
+  if (GRID__NONE != g->next[id]) {
+    g->prev[g->next[id]] = g->prev[id];
+  }
+  g->bucket[id] = GRID__NONE;
+}
+
+// Update position; relinks only when the cell changes
+// @returns false if id is not in the grid
+bool Grid__move(Grid* g, u32 id, f32 x, f32 y) {
+  if (id >= g->cap || GRID__NONE == g->bucket[id]) {
+    return false;
+  }
+  g->x[id] = x;
+  g->y[id] = y;
+  s32 cx = _Grid__cell(g, x), cy = _Grid__cell(g, y);
+  if (cx != g->cx[id] || cy != g->cy[id]) {
+    g->cx[id] = cx;
+    g->cy[id] = cy;
+    u32 b = _Grid__hash(g, cx, cy);
+    if (b != g->bucket[id]) {
+      _Grid__unlink(g, id);
+      _Grid__link(g, id, b);
+    }
+  }
+  return true;
+}
+
+// Add item, or move it if already present
+void Grid__insert(Grid* g, u32 id, f32 x, f32 y) {
+  ASSERT_CONTEXT(id < g->cap, "Grid id %u out of range (cap %u)", id, g->cap);
+  if (Grid__move(g, id, x, y)) {
+    return;
+  }
+  g->x[id] = x;
+  g->y[id] = y;
+  g->cx[id] = _Grid__cell(g, x);
+  g->cy[id] = _Grid__cell(g, y);
+  _Grid__link(g, id, _Grid__hash(g, g->cx[id], g->cy[id]));
+  g->len++;
+}
+
+// Take item out of the grid
+// @returns false if id was not in the grid
+bool Grid__remove(Grid* g, u32 id) {
+  if (id >= g->cap || GRID__NONE == g->bucket[id]) {
+    return false;
+  }
+  _Grid__unlink(g, id);
+  g->len--;
+  return true;
+}
+
+// append items of bucket b in cell range [cx0..cx1]x[cy0..cy1] that pass the box (+ radius) test
+// each item is reported only from its own cell, so colliding cells never double-count
+static u32 _Grid__scan(
+    Grid* g, u32 b, const s32* cells, const f32* box, f32 r2, u32* out, u32 ct, u32 max) {
+  for (u32 id = g->heads[b]; GRID__NONE != id && ct < max; id = g->next[id]) {
+    if (g->cx[id] < cells[0] || g->cx[id] > cells[2] || g->cy[id] < cells[1] ||
+        g->cy[id] > cells[3]) {
+      continue;  // hash collision from outside the query
+    }
+    f32 x = g->x[id], y = g->y[id];
+    if (x < box[0] || y < box[1] || x > box[2] || y > box[3]) {
+      continue;
+    }
+    if (r2 >= 0.0f) {
+      f32 dx = x - box[4], dy = y - box[5];
+      if (dx * dx + dy * dy > r2) {
+        continue;
+      }
+    }
+    out[ct++] = id;
+  }
+  return ct;
+}
+
+// box = {minX, minY, maxX, maxY, centerX, centerY}; r2 < 0 = box only
+static u32 _Grid__query(Grid* g, const f32* box, f32 r2, u32* out, u32 max) {
+  s32 cells[4] = {
+      _Grid__cell(g, box[0]),
+      _Grid__cell(g, box[1]),
+      _Grid__cell(g, box[2]),
+      _Grid__cell(g, box[3]),
+  };
+  u64 cellCt = (u64)(cells[2] - cells[0] + 1) * (u64)(cells[3] - cells[1] + 1);
+  u32 ct = 0;
+  if (cellCt > (u64)g->bucketMask + 1) {
+    // box spans more cells than buckets; walking every bucket once is cheaper
+    for (u32 b = 0; b <= g->bucketMask && ct < max; b++) {
+      ct = _Grid__scan(g, b, cells, box, r2, out, ct, max);
+    }
+    return ct;
+  }
+  for (s32 cy = cells[1]; cy <= cells[3]; cy++) {
+    for (s32 cx = cells[0]; cx <= cells[2]; cx++) {
+      s32 cell[4] = {cx, cy, cx, cy};
+      ct = _Grid__scan(g, _Grid__hash(g, cx, cy), cell, box, r2, out, ct, max);
+    }
+  }
+  return ct;
+}
+
+// Items inside the box (inclusive)
+// @returns count written to out (stops at max)
+u32 Grid__queryAabb(Grid* g, f32 minX, f32 minY, f32 maxX, f32 maxY, u32* out, u32 max) {
+  f32 box[6] = {minX, minY, maxX, maxY, 0.0f, 0.0f};
+  return _Grid__query(g, box, -1.0f, out, max);
+}
+
+// Items within r of (x, y)
+// @returns count written to out (stops at max)
+u32 Grid__queryRadius(Grid* g, f32 x, f32 y, f32 r, u32* out, u32 max) {
+  f32 box[6] = {x - r, y - r, x + r, y + r, x, y};
+  return _Grid__query(g, box, r * r, out, max);
+}
+
+// ---
+// GridView
+
+// Empty visible set for item ids 0..cap-1
+bool GridView__init(GridView* v, Arena* arena, u32 cap) {
+  v->len = 0;
+  v->ids = Arena__pushArray(arena, u32, cap);
+  v->bits = Arena__pushArrayZ(arena, u64, (cap + 63) / 64);
+  return NULL != v->ids && NULL != v->bits;
+}
+
+#define _GRIDVIEW__BIT(v, id) ((v)->bits[(id) >> 6] & (1ull << ((id) & 63)))
+
+// Set visible ids; report entered/left/stayed
+// ids must be unique (as Grid queries return); diff arrays are pushed on arena
+// O(old + new), no sorting
+bool GridView__diff(GridView* v, const u32* ids, u32 ct, Arena* arena, GridDiff* diff) {
+  memset(diff, 0, sizeof(GridDiff));
+  diff->entered = Arena__pushArray(arena, u32, ct);
+  diff->stayed = Arena__pushArray(arena, u32, ct);
+  diff->left = Arena__pushArray(arena, u32, v->len);
+  if ((0 != ct && (NULL == diff->entered || NULL == diff->stayed)) ||
+      (0 != v->len && NULL == diff->left)) {
+    return false;
+  }
+  for (u32 i = 0; i < ct; i++) {
+    u32 id = ids[i];
+    if (_GRIDVIEW__BIT(v, id)) {
+      diff->stayed[diff->stayedCt++] = id;
+      v->bits[id >> 6] &= ~(1ull << (id & 63));  // whatever stays set afterwards has left
+    } else {
+      diff->entered[diff->enteredCt++] = id;
+    }
+  }
+  for (u32 i = 0; i < v->len; i++) {
+    u32 id = v->ids[i];
+    if (_GRIDVIEW__BIT(v, id)) {
+      diff->left[diff->leftCt++] = id;
+      v->bits[id >> 6] &= ~(1ull << (id & 63));
+    }
+  }
+  for (u32 i = 0; i < ct; i++) {
+    v->bits[ids[i] >> 6] |= 1ull << (ids[i] & 63);
+  }
+  memcpy(v->ids, ids, (u64)ct * sizeof(u32));
+  v->len = ct;
+  return true;
+}
\ No newline at end of file
@@ -0,0 +1,328 @@
+#pragma once
+
+#include "../unity.h"  // IWYU pragma: keep
+
+// inspired by:
+// - [2017 Matt Kulukundis - CppCon: Designing a Fast, Efficient Hash Table](https://www.youtube.com/watch?v=ncHmEUmJZf4)
+// - [Abseil - Swiss Tables Design Notes](https://abseil.io/about/design/swisstables)
+// - [Wang Yi - wyhash](https://github.com/wangyi-fudan/wyhash)
+
+// @class Hash
+// Function | Purpose
+// --- | ---
+// Hash__u64(x) | Mix an integer key (splitmix64 finalizer)
+// Hash__ptr(p) | Hash a pointer key
+// Hash__bytes(p, len) | Hash a byte string (wyhash)
+
+// @class HashMap (generated by GENERIC_HASHMAP_FNS)
+// Function | Purpose
+// --- | ---
+// N__init(m, arena, ct) | Allocate a table that holds ct entries without growing
+// N__get(m, key) | Pointer to value, or NULL
+// N__has(m, key) | Is key present?
+// N__put(m, key, val) | Insert or overwrite; returns pointer to stored value
+// N__remove(m, key) | Remove key; false if absent
+// N__each(m, &it) | Next entry (it starts at 0), or NULL when done
+// N__clear(m) | Remove all entries (keeps capacity)
+
+// usage:
+//   GENERIC_HASHMAP(SessionMap, u64, Session*);  // type (see unity.h)
+//   GENERIC_HASHMAP_FNS(SessionMap, u64, Session*, Hash__u64, HASHMAP__EQ);  // functions
+//   SessionMap__init(&_G->sessions, _G->arena, 1024);
+//   SessionMap__put(&_G->sessions, peerAddr, session);
+//   Session** s = SessionMap__get(&_G->sessions, peerAddr);
+//
+//   SessionMap__Entry* e;
+//   for (u32 it = 0; NULL != (e = SessionMap__each(&_G->sessions, &it));) { ... }
+
+// NOTE: pointers from get()/put() are valid until the next put() (which may rehash)
+
+#define HASHMAP__EQ(a, b) ((a) == (b))
+#define HASHMAP__MAX_LOAD(cap) ((cap) - (cap) / 8)  // 7/8 full, then grow
+
+// ---
+// Hash
+
+// Mix an integer key (splitmix64 finalizer)
+static inline u64 Hash__u64(u64 x) {
+  x ^= x >> 30;
+  x *= 0xbf58476d1ce4e5b9ull;
+  x ^= x >> 27;
+  x *= 0x94d049bb133111ebull;
+  return x ^ (x >> 31);
+}
+
+// Hash a pointer key
+#define Hash__ptr(p) Hash__u64((u64)(uintptr_t)(p))
+
+// 64x64 -> 128 multiply; *a = low half, *b = high half
+static inline void _Hash__mum(u64* a, u64* b) {
+#ifdef __SIZEOF_INT128__
+  __uint128_t r = (__uint128_t)*a * *b;
+  *a = (u64)r;
+  *b = (u64)(r >> 64);
+#else
+  u64 ha = *a >> 32, hb = *b >> 32, la = (u32)*a, lb = (u32)*b;
+  u64 rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+  u64 t = rl + (rm0 << 32), c = t < rl;
+  u64 lo = t + (rm1 << 32);
+  c += lo < t;
+  *a = lo;
+  *b = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+#endif
+}
+
+// multiply, then fold the halves
+static inline u64 _Hash__mix(u64 a, u64 b) {
+  _Hash__mum(&a, &b);
+  return a ^ b;
+}
+
+static inline u64 _Hash__r8(const u8* p) {
+  u64 v;
+  memcpy(&v, p, 8);
+  return v;
+}
+
+static inline u64 _Hash__r4(const u8* p) {
+  u32 v;
+  memcpy(&v, p, 4);
+  return v;
+}
+
+// Hash a byte string (wyhash)
+u64 Hash__bytes(const void* key, u64 len) {
+  static const u64 s[4] = {
+      0xa0761d6478bd642full,
+      0xe7037ed1a0b428dbull,
+      0x8ebc6af09c88c6e3ull,
+      0x589965cc75374cc3ull,
+  };
+  const u8* p = (const u8*)key;
+  u64 seed = _Hash__mix(s[0], s[1]);
+  u64 a, b;
+  if (len <= 16) {
+    if (len >= 4) {
+      a = (_Hash__r4(p) << 32) | _Hash__r4(p + ((len >> 3) << 2));
+      b = (_Hash__r4(p + len - 4) << 32) | _Hash__r4(p + len - 4 - ((len >> 3) << 2));
+    } else if (len > 0) {
+      a = ((u64)p[0] << 16) | ((u64)p[len >> 1] << 8) | p[len - 1];
+      b = 0;
+    } else {
+      a = b = 0;
+    }
+  } else {
+    u64 i = len;
+    if (i > 48) {
+      u64 see1 = seed, see2 = seed;
+      do {
+        seed = _Hash__mix(_Hash__r8(p) ^ s[1], _Hash__r8(p + 8) ^ seed);
+        see1 = _Hash__mix(_Hash__r8(p + 16) ^ s[2], _Hash__r8(p + 24) ^ see1);
+        see2 = _Hash__mix(_Hash__r8(p + 32) ^ s[3], _Hash__r8(p + 40) ^ see2);
+        p += 48;
+        i -= 48;
+      } while (i > 48);
+      seed ^= see1 ^ see2;
+    }
+    while (i > 16) {
+      seed = _Hash__mix(_Hash__r8(p) ^ s[1], _Hash__r8(p + 8) ^ seed);
+      i -= 16;
+      p += 16;
+    }
+    a = _Hash__r8(p + i - 16);
+    b = _Hash__r8(p + i - 8);
+  }
+  a ^= s[1];
+  b ^= seed;
+  _Hash__mum(&a, &b);
+  return _Hash__mix(a ^ s[0] ^ len, b ^ s[1]);
+}
+
+// ---
+// Control groups
+
+// bit i set = ctrl[i] == h2
+static inline u32 _HashMap__match(const u8* ctrl, u8 h2) {
+#ifdef __SSE2__
+  __m128i g = _mm_load_si128((const __m128i*)ctrl);
+  return (u32)_mm_movemask_epi8(_mm_cmpeq_epi8(g, _mm_set1_epi8((char)h2)));
+#else
+  u32 bits = 0;
+  for (u32 i = 0; i < HASHMAP__GROUP; i++) {
+    bits |= (u32)(ctrl[i] == h2) << i;
+  }
+  return bits;
+#endif
+}
+
+// bit i set = ctrl[i] is EMPTY or DELETED (high bit set)
+static inline u32 _HashMap__matchFree(const u8* ctrl) {
+#ifdef __SSE2__
+  return (u32)_mm_movemask_epi8(_mm_load_si128((const __m128i*)ctrl));
+#else
+  u32 bits = 0;
+  for (u32 i = 0; i < HASHMAP__GROUP; i++) {
+    bits |= (u32)(ctrl[i] >> 7) << i;
+  }
+  return bits;
+#endif
+}
+
+// does the group still have a never-used slot? (then no probe ever continued past it)
+static inline bool _HashMap__hasEmpty(const u8* ctrl) {
+  return 0 != _HashMap__match(ctrl, HASHMAP__EMPTY);
+}
+
+// first EMPTY/DELETED slot along hash's probe sequence (table must have one)
+// groups are visited in triangular steps, which covers every group of a power-of-2 table
+static u32 _HashMap__findFree(const u8* ctrl, u32 cap, u64 hash) {
+  u32 mask = cap / HASHMAP__GROUP - 1;
+  u32 g = (u32)(hash >> 7) & mask;
+  for (u32 step = 1;; step++) {
+    u32 bits = _HashMap__matchFree(ctrl + g * HASHMAP__GROUP);
+    if (0 != bits) {
+      return g * HASHMAP__GROUP + __builtin_ctz(bits);
+    }
+    g = (g + step) & mask;
+  }
+}
+
+// slots needed to hold ct entries under the max load factor
+static u32 _HashMap__capFor(u32 ct) {
+  u32 cap = HASHMAP__GROUP;
+  while (HASHMAP__MAX_LOAD(cap) < ct) {
+    cap <<= 1;
+  }
+  return cap;
+}
+
+// ---
+// Typed map
+
+#define GENERIC_HASHMAP_FNS(N, K, V, HASH, EQ)                                          \
+  /* point m at a fresh, empty table of cap slots (len is kept) */                      \
+  static inline bool _##N##__alloc(N* m, u32 cap) {                                     \
+    u8* ctrl = (u8*)Arena__pushAligned(m->arena, cap, HASHMAP__GROUP);                  \
+    N##__Entry* slots = Arena__pushArray(m->arena, N##__Entry, cap);                    \
+    if (NULL == ctrl || NULL == slots) {                                                \
+      return false;                                                                     \
+    }                                                                                   \
+    memset(ctrl, HASHMAP__EMPTY, cap);                                                  \
+    m->ctrl = ctrl;                                                                     \
+    m->slots = slots;                                                                   \
+    m->cap = cap;                                                                       \
+    m->growthLeft = HASHMAP__MAX_LOAD(cap) - m->len;                                    \
+    return true;                                                                        \
+  }                                                                                     \
+                                                                                        \
+  /* Allocate a table that holds ct entries without growing */                          \
+  static inline bool N##__init(N* m, Arena* arena, u32 ct) {                            \
+    m->arena = arena;                                                                   \
+    m->len = 0;                                                                         \
+    return _##N##__alloc(m, _HashMap__capFor(ct));                                      \
+  }                                                                                     \
+                                                                                        \
+  /* entry for key, or NULL; stops at the first group with an EMPTY slot */             \
+  static inline N##__Entry* _##N##__find(N* m, K key, u64 hash) {                       \
+    u32 mask = m->cap / HASHMAP__GROUP - 1;                                             \
+    u32 g = (u32)(hash >> 7) & mask;                                                    \
+    u8 h2 = (u8)(hash & 0x7f);                                                          \
+    for (u32 step = 1; step <= mask + 1; step++) {                                      \
+      const u8* ctrl = m->ctrl + g * HASHMAP__GROUP;                                    \
+      for (u32 bits = _HashMap__match(ctrl, h2); 0 != bits; bits &= bits - 1) {         \
+        N##__Entry* e = &m->slots[g * HASHMAP__GROUP + __builtin_ctz(bits)];            \
+        if (EQ(e->key, key)) {                                                          \
+          return e;                                                                     \
+        }                                                                               \
+      }                                                                                 \
+      if (_HashMap__hasEmpty(ctrl)) {                                                   \
+        return NULL;                                                                    \
+      }                                                                                 \
+      g = (g + step) & mask;                                                            \
+    }                                                                                   \
+    return NULL;                                                                        \
+  }                                                                                     \
+                                                                                        \
+  /* Pointer to value, or NULL */                                                       \
+  static inline V* N##__get(N* m, K key) {                                              \
+    N##__Entry* e = _##N##__find(m, key, HASH(key));                                    \
+    return NULL != e ? &e->val : NULL;                                                  \
+  }                                                                                     \
+                                                                                        \
+  /* Is key present? */                                                                 \
+  static inline bool N##__has(N* m, K key) {                                            \
+    return NULL != _##N##__find(m, key, HASH(key));                                     \
+  }                                                                                     \
+                                                                                        \
+  /* rebuild into a fresh table; doubles only when live entries need it */              \
+  static inline bool _##N##__rehash(N* m) {                                             \
+    u8* ctrl = m->ctrl;                                                                 \
+    N##__Entry* slots = m->slots;                                                       \
+    u32 cap = m->cap;                                                                   \
+    if (!_##N##__alloc(m, _HashMap__capFor(m->len + 1 + m->len / 2))) {                 \
+      return false;                                                                     \
+    }                                                                                   \
+    for (u32 i = 0; i < cap; i++) {                                                     \
+      if (!(ctrl[i] & 0x80)) {                                                          \
+        u64 hash = HASH(slots[i].key);                                                  \
+        u32 j = _HashMap__findFree(m->ctrl, m->cap, hash);                              \
+        m->ctrl[j] = (u8)(hash & 0x7f);                                                 \
+        m->slots[j] = slots[i];                                                         \
+      }                                                                                 \
+    }                                                                                   \
+    return true;                                                                        \
+  }                                                                                     \
+                                                                                        \
+  /* Insert or overwrite; returns pointer to stored value (NULL if arena full) */       \
+  static inline V* N##__put(N* m, K key, V val) {                                       \
+    u64 hash = HASH(key);                                                               \
+    N##__Entry* e = _##N##__find(m, key, hash);                                         \
+    if (NULL == e) {                                                                    \
+      if (0 == m->growthLeft && !_##N##__rehash(m)) {                                   \
+        return NULL;                                                                    \
+      }                                                                                 \
+      u32 i = _HashMap__findFree(m->ctrl, m->cap, hash);                                \
+      m->growthLeft -= HASHMAP__EMPTY == m->ctrl[i]; /* reusing a tombstone is free */  \
+      m->ctrl[i] = (u8)(hash & 0x7f);                                                   \
+      m->len++;                                                                         \
+      e = &m->slots[i];                                                                 \
+      e->key = key;                                                                     \
+    }                                                                                   \
+    e->val = val;                                                                       \
+    return &e->val;                                                                     \
+  }                                                                                     \
+                                                                                        \
+  /* Remove key; false if absent */                                                     \
+  static inline bool N##__remove(N* m, K key) {                                         \
+    N##__Entry* e = _##N##__find(m, key, HASH(key));                                    \
+    if (NULL == e) {                                                                    \
+      return false;                                                                     \
+    }                                                                                   \
+    u32 i = (u32)(e - m->slots);                                                        \
+    if (_HashMap__hasEmpty(m->ctrl + (i & ~(HASHMAP__GROUP - 1)))) {                    \
+      m->ctrl[i] = HASHMAP__EMPTY; /* group never filled; no probe passed through it */ \
+      m->growthLeft++;                                                                  \
+    } else {                                                                            \
+      m->ctrl[i] = HASHMAP__DELETED;                                                    \
+    }                                                                                   \
+    m->len--;                                                                           \
+    return true;                                                                        \
+  }                                                                                     \
+                                                                                        \
+  /* Next entry (it starts at 0), or NULL when done */                                  \
+  static inline N##__Entry* N##__each(N* m, u32* it) {                                  \
+    while (*it < m->cap) {                                                              \
+      u32 i = (*it)++;                                                                  \
+      if (!(m->ctrl[i] & 0x80)) {                                                       \
+        return &m->slots[i];                                                            \
+      }                                                                                 \
+    }                                                                                   \
+    return NULL;                                                                        \
+  }                                                                                     \
+                                                                                        \
+  /* Remove all entries (keeps capacity) */                                             \
+  static inline void N##__clear(N* m) {                                                 \
+    memset(m->ctrl, HASHMAP__EMPTY, m->cap);                                            \
+    m->len = 0;                                                                         \
+    m->growthLeft = HASHMAP__MAX_LOAD(m->cap);                                          \
+  }
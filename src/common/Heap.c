@@ -0,0 +1,175 @@
+#pragma once
+
+#include "../unity.h"  // IWYU pragma: keep
+
+// inspired by:
+// - [1975 Donald B. Johnson - Priority queues with update and finding minimum spanning trees](https://doi.org/10.1016/0020-0190(75)90001-0)
+// - [2010 Poul-Henning Kamp - You're Doing It Wrong](https://queue.acm.org/detail.cfm?id=1814327)
+
+// @class Heap (generated by GENERIC_HEAP_FNS)
+// Function | Purpose
+// --- | ---
+// N__init(h, arena, cap) | Empty heap with room for cap items (grows on demand)
+// N__push(h, item) | Insert; returns a handle for update/remove (HEAP__NONE if arena full)
+// N__peek(h) | Smallest item, or NULL if empty
+// N__pop(h, out) | Remove smallest item into out; false if empty
+// N__get(h, handle) | Item for a live handle (read-only; use update to change it)
+// N__update(h, handle, item) | Replace item + restore order (decrease-key or increase-key)
+// N__remove(h, handle) | Remove item by handle; false if handle not live
+
+// usage:
+//   #define Event__less(a, b) ((a).at < (b).at)
+//   GENERIC_HEAP(EventQ, Event);  // type (see unity.h)
+//   GENERIC_HEAP_FNS(EventQ, Event, Event__less);  // functions; comparison is inlined
+//   EventQ__init(&_G->events, _G->arena, 256);
+//   u32 h = EventQ__push(&_G->events, (Event){.at = now + 500});
+//   EventQ__update(&_G->events, h, (Event){.at = now + 100});  // decrease-key
+//   Event e;
+//   while (EventQ__peek(&_G->events) && EventQ__peek(&_G->events)->at <= now)
+//     EventQ__pop(&_G->events, &e);
+
+// NOTE: a handle is freed by pop()/remove() and may be handed out again by a later push()
+
+#define GENERIC_HEAP_FNS(N, T, LESS)                                                  \
+  /* move node i toward the root until its parent is not larger */                    \
+  static inline void _##N##__siftUp(N* h, u32 i) {                                    \
+    N##__Node node = h->nodes[i];                                                     \
+    while (i > 0) {                                                                   \
+      u32 p = (i - 1) / HEAP__D;                                                      \
+      if (!(LESS(node.item, h->nodes[p].item))) {                                     \
+        break;                                                                        \
+      }                                                                               \
+      h->nodes[i] = h->nodes[p];                                                      \
+      h->pos[h->nodes[i].handle] = i;                                                 \
+      i = p;                                                                          \
+    }                                                                                 \
+    h->nodes[i] = node;                                                               \
+    h->pos[node.handle] = i;                                                          \
+  }                                                                                   \
+                                                                                      \
+  /* move node i toward the leaves until no child is smaller */                       \
+  static inline void _##N##__siftDown(N* h, u32 i) {                                  \
+    N##__Node node = h->nodes[i];                                                     \
+    for (;;) {                                                                        \
+      u32 c = i * HEAP__D + 1;                                                        \
+      if (c >= h->len) {                                                              \
+        break;                                                                        \
+      }                                                                               \
+      u32 end = c + HEAP__D < h->len ? c + HEAP__D : h->len;                          \
+      u32 best = c;                                                                   \
+      for (u32 k = c + 1; k < end; k++) {                                             \
+        if (LESS(h->nodes[k].item, h->nodes[best].item)) {                            \
+          best = k;                                                                   \
+        }                                                                             \
+      }                                                                               \
+      if (!(LESS(h->nodes[best].item, node.item))) {                                  \
+        break;                                                                        \
+      }                                                                               \
+      h->nodes[i] = h->nodes[best];                                                   \
+      h->pos[h->nodes[i].handle] = i;                                                 \
+      i = best;                                                                       \
+    }                                                                                 \
+    h->nodes[i] = node;                                                               \
+    h->pos[node.handle] = i;                                                          \
+  }                                                                                   \
+                                                                                      \
+  /* Empty heap with room for cap items (grows on demand) */                          \
+  static inline bool N##__init(N* h, Arena* arena, u32 cap) {                         \
+    memset(h, 0, sizeof(N));                                                          \
+    h->arena = arena;                                                                 \
+    cap = 0 == cap ? 1 : cap;                                                         \
+    h->nodes = Arena__pushArray(arena, N##__Node, cap);                               \
+    h->pos = Arena__pushArray(arena, u32, cap);                                       \
+    h->spare = Arena__pushArray(arena, u32, cap);                                     \
+    h->cap = cap;                                                                     \
+    return NULL != h->nodes && NULL != h->pos && NULL != h->spare;                    \
+  }                                                                                   \
+                                                                                      \
+  /* double capacity; handles stay valid */                                           \
+  static inline bool _##N##__grow(N* h) {                                             \
+    u32 cap = h->cap * 2;                                                             \
+    N##__Node* nodes = Arena__pushArray(h->arena, N##__Node, cap);                    \
+    u32* pos = Arena__pushArray(h->arena, u32, cap);                                  \
+    u32* spare = Arena__pushArray(h->arena, u32, cap);                                \
+    if (NULL == nodes || NULL == pos || NULL == spare) {                              \
+      return false;                                                                   \
+    }                                                                                 \
+    memcpy(nodes, h->nodes, (u64)h->len * sizeof(N##__Node));                         \
+    memcpy(pos, h->pos, (u64)h->cap * sizeof(u32));                                   \
+    memcpy(spare, h->spare, (u64)h->spareCt * sizeof(u32));                           \
+    h->nodes = nodes;                                                                 \
+    h->pos = pos;                                                                     \
+    h->spare = spare;                                                                 \
+    h->cap = cap;                                                                     \
+    return true;                                                                      \
+  }                                                                                   \
+                                                                                      \
+  /* Insert; returns a handle for update/remove (HEAP__NONE if arena full) */         \
+  static inline u32 N##__push(N* h, T item) {                                         \
+    if (h->len == h->cap && !_##N##__grow(h)) {                                       \
+      return HEAP__NONE;                                                              \
+    }                                                                                 \
+    /* handles in use == len, so a fresh one is always < cap */                       \
+    u32 handle = 0 != h->spareCt ? h->spare[--h->spareCt] : h->len;                   \
+    u32 i = h->len++;                                                                 \
+    h->nodes[i].item = item;                                                          \
+    h->nodes[i].handle = handle;                                                      \
+    _##N##__siftUp(h, i);                                                             \
+    return handle;                                                                    \
+  }                                                                                   \
+                                                                                      \
+  /* Smallest item, or NULL if empty */                                               \
+  static inline T* N##__peek(N* h) {                                                  \
+    return 0 != h->len ? &h->nodes[0].item : NULL;                                    \
+  }                                                                                   \
+                                                                                      \
+  /* Item for a live handle (read-only; use update to change it) */                   \
+  static inline const T* N##__get(N* h, u32 handle) {                                 \
+    /* handles issued so far == len + spareCt; pos[] past that is uninitialized */    \
+    bool live = handle < h->len + h->spareCt && HEAP__NONE != h->pos[handle];         \
+    return live ? &h->nodes[h->pos[handle]].item : NULL;                              \
+  }                                                                                   \
+                                                                                      \
+  /* Remove item by handle; false if handle not live */                               \
+  static inline bool N##__remove(N* h, u32 handle) {                                  \
+    if (NULL == N##__get(h, handle)) {                                                \
+      return false;                                                                   \
+    }                                                                                 \
+    u32 i = h->pos[handle];                                                           \
+    h->pos[handle] = HEAP__NONE;                                                      \
+    h->spare[h->spareCt++] = handle;                                                  \
+    if (i != --h->len) {                                                              \
+      h->nodes[i] = h->nodes[h->len]; /* last leaf fills the hole, then re-settles */ \
+      if (i > 0 && LESS(h->nodes[i].item, h->nodes[(i - 1) / HEAP__D].item)) {        \
+        _##N##__siftUp(h, i);                                                         \
+      } else {                                                                        \
+        _##N##__siftDown(h, i);                                                       \
+      }                                                                               \
+    }                                                                                 \
+    return true;                                                                      \
+  }                                                                                   \
+                                                                                      \
+  /* Remove smallest item into out; false if empty */                                 \
+  static inline bool N##__pop(N* h, T* out) {                                         \
+    if (0 == h->len) {                                                                \
+      return false;                                                                   \
+    }                                                                                 \
+    *out = h->nodes[0].item;                                                          \
+    return N##__remove(h, h->nodes[0].handle);                                        \
+  }                                                                                   \
+                                                                                      \
+  /* Replace item + restore order (decrease-key or increase-key) */                   \
+  static inline bool N##__update(N* h, u32 handle, T item) {                          \
+    if (NULL == N##__get(h, handle)) {                                                \
+      return false;                                                                   \
+    }                                                                                 \
+    u32 i = h->pos[handle];                                                           \
+    bool up = LESS(item, h->nodes[i].item);                                           \
+    h->nodes[i].item = item;                                                          \
+    if (up) {                                                                         \
+      _##N##__siftUp(h, i);                                                           \
+    } else {                                                                          \
+      _##N##__siftDown(h, i);                                                         \
+    }                                                                                 \
+    return true;                                                                      \
+  }
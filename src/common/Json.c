@@ -20,6 +20,7 @@
 // Json__object_begin(json) | Begin parsing JSON object
 // Json__object_key(json, str) | Parse next object key
 // Json__object_key_is(json, len, expected) | Check if key matches expected string
+// Json__object_key_id(json, id) | Parse next object key as an interned id
 // Json__object_end(json) | End parsing JSON object
 // Json__any(json) | Consume any next token
 
@@ -350,9 +351,21 @@ bool Json__object_key_is(Json* json, u32 len, const char* expected) {
   Str8 key = {0};
   return  //
       Json__object_key(json, &key) &&  //
+      len == key.len &&  // key is a slice; don't accept a longer key with the same prefix
       cstr__eq(len, expected, key.str);  //
 }
 
+// as Json__object_key(), resolved to its Str8__intern() id for integer-compare dispatch.
+// keys never interned yield STR8__ID_NONE (no handler can match them)
+bool Json__object_key_id(Json* json, StrId* id) {
+  Str8 key = {0};
+  if (!Json__object_key(json, &key)) {
+    return false;
+  }
+  *id = Str8__find(&key);
+  return true;
+}
+
 // expect closing curly brace
 bool Json__object_end(Json* json) {
   return _Json__expect_next_token(json, JSON_CCURLY);
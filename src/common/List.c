@@ -2,17 +2,74 @@
 
 #include "../unity.h"  // IWYU pragma: keep
 
+// usage:
+//   // long-lived queue with churn: nodes are recycled, so memory stays bounded
+//   Pool* nodes = Arena__pushStruct(_G->arena, Pool);
+//   Pool__init(nodes, _G->arena, sizeof(List__Node), 0);
+//   List* q = List__allocPool(_G->arena, nodes);
+//   List__append(NULL, q, msg);  // arena unused when the list has a pool
+//   msg = List__shift(q);  // node goes back to the pool
+//
+//   // per-frame list: nodes come from the arena and vanish with it
+//   List* l = List__alloc(_G->frameArena);
+
 // ---
 // Linked List
 
+// take a node from the list's pool, or the arena when it has none
+// @returns NULL if the pool's arena (or the arena) is exhausted
+static List__Node* _List__node(Arena* arena, List* list, void* data) {
+  List__Node* node = NULL != list->pool ? (List__Node*)Pool__alloc(list->pool)
+                                        : Arena__pushStruct(arena, List__Node);
+  if (NULL == node) {
+    return NULL;
+  }
+  node->data = data;
+  node->next = NULL;
+  return node;
+}
+
+// recycle a node unlinked from the list (arena nodes are left for the arena reset)
+static void _List__release(List* list, List__Node* node) {
+  if (NULL != list->pool) {
+    Pool__free(list->pool, node);
+  }
+}
+
+void List__init(List* list, Pool* pool) {
+  ASSERT_CONTEXT(
+      NULL == pool || sizeof(List__Node) <= pool->slotSz,
+      "List pool slots are %u bytes; need %u",
+      pool->slotSz,
+      (u32)sizeof(List__Node));
+  list->len = 0;
+  list->head = list->tail = NULL;
+  list->pool = pool;
+}
+
+// empty the list; pooled nodes go back to the pool
+// arena-backed lists skip the walk (O(1)); their nodes are reclaimed with the arena
 void List__reset(List* list) {
+  List__Node* c = NULL != list->pool ? list->head : NULL;
+  while (NULL != c) {
+    List__Node* next = c->next;
+    _List__release(list, c);
+    c = next;
+  }
   list->len = 0;
-  list->head = NULL;
+  list->head = list->tail = NULL;
 }
 
 List* List__alloc(Arena* arena) {
-  List* list = (List*)Arena__push(arena, sizeof(List));
-  List__reset(list);
+  List* list = Arena__pushStruct(arena, List);
+  List__init(list, NULL);
+  return list;
+}
+
+// list whose nodes come from (and return to) pool; arena only holds the List itself
+List* List__allocPool(Arena* arena, Pool* pool) {
+  List* list = Arena__pushStruct(arena, List);
+  List__init(list, pool);
   return list;
 }
 
@@ -50,20 +107,24 @@ void* List__shift(List* list) {
   List__Node* c = list->head;
   if (0 == list->len)
     return NULL;
+  void* data = c->data;
   if (1 == list->len) {
     list->head = list->tail = NULL;
     list->len = 0;
-    return c->data;
+  } else {
+    list->head = c->next;
+    list->len--;
   }
-  list->head = c->next;
-  list->len--;
-  return c->data;
+  _List__release(list, c);
+  return data;
 }
 
-void List__prepend(Arena* arena, List* list, void* data) {
-  List__Node* node = (List__Node*)Arena__push(arena, sizeof(List__Node));
-  node->data = data;
-  node->next = NULL;
+// @returns false (list unchanged) if no node could be allocated
+bool List__prepend(Arena* arena, List* list, void* data) {
+  List__Node* node = _List__node(arena, list, data);
+  if (NULL == node) {
+    return false;
+  }
 
   if (0 == list->len) {
     list->head = node;
@@ -73,12 +134,15 @@ void List__prepend(Arena* arena, List* list, void* data) {
     list->head = node;
   }
   list->len++;
+  return true;
 }
 
-void List__append(Arena* arena, List* list, void* data) {
-  List__Node* node = (List__Node*)Arena__push(arena, sizeof(List__Node));
-  node->data = data;
-  node->next = NULL;
+// @returns false (list unchanged) if no node could be allocated
+bool List__append(Arena* arena, List* list, void* data) {
+  List__Node* node = _List__node(arena, list, data);
+  if (NULL == node) {
+    return false;
+  }
 
   if (0 == list->len) {
     list->head = node;
@@ -88,6 +152,7 @@ void List__append(Arena* arena, List* list, void* data) {
     list->tail = node;
   }
   list->len++;
+  return true;
 }
 
 void* List__get(List* list, u32 index) {
@@ -103,24 +168,32 @@ void* List__get(List* list, u32 index) {
 
 bool List__remove_item(List* list, void* data) {
   List__Node* c = list->head;
+  if (NULL == c) {
+    return false;
+  }
 
   // special case for head
   if (c->data == data) {
     list->head = c->next;
     list->len--;
+    if (NULL == list->head) {
+      list->tail = NULL;
+    }
+    _List__release(list, c);
     return true;
   }
 
-  for (u32 i = 0; i < list->len; i++) {
+  for (; NULL != c->next; c = c->next) {
     if (c->next->data == data) {
-      c->next = c->next->next;
+      List__Node* found = c->next;
+      c->next = found->next;
       list->len--;
       if (NULL == c->next) {
         list->tail = c;
       }
+      _List__release(list, found);
       return true;
     }
-    c = c->next;
   }
   return false;
 }
@@ -132,16 +205,20 @@ void* List__pop(List* list) {
     return NULL;
   }
   if (1 == list->len) {
+    void* data = c->data;
     list->head = list->tail = NULL;
     list->len = 0;
-    return c->data;
+    _List__release(list, c);
+    return data;
   }
   for (u32 i = 0; i < list->len; i++) {
     if (i == list->len - 1) {
+      void* data = c->data;
       list->tail = prev;
       list->tail->next = NULL;
       list->len--;  // update
-      return c->data;  // return last
+      _List__release(list, c);
+      return data;  // return last
     }
     prev = c;
     c = c->next;
@@ -150,17 +227,19 @@ void* List__pop(List* list) {
 }
 
 // insert in sorted position
-void List__insort(Arena* arena, List* list, void* data, List__sorter_t sortCb) {
-  List__Node* node = (List__Node*)Arena__push(arena, sizeof(List__Node));
-  node->data = data;
-  node->next = NULL;
+// @returns false (list unchanged) if no node could be allocated
+bool List__insort(Arena* arena, List* list, void* data, List__sorter_t sortCb) {
+  List__Node* node = _List__node(arena, list, data);
+  if (NULL == node) {
+    return false;
+  }
 
   // special case for first node
   if (NULL == list->head) {
     list->head = node;
     list->tail = node;
     list->len++;
-    return;
+    return true;
   }
 
   // locate the node before the point of insertion
@@ -177,6 +256,7 @@ void List__insort(Arena* arena, List* list, void* data, List__sorter_t sortCb) {
     list->tail = node;
   }
   list->len++;
+  return true;
 }
 
 bool List__has_item(List* list, void* data) {
@@ -0,0 +1,223 @@
+#pragma once
+
+#include "../unity.h"  // IWYU pragma: keep
+
+// inspired by:
+// - [Intel TBB - parallel_for / parallel_reduce](https://oneapi-src.github.io/oneTBB/main/tbb_userguide/Parallelizing_Simple_Loops.html)
+
+// @class Parallel
+// Function | Purpose
+// --- | ---
+// Parallel__init(workerCt) | Start worker pool (0 = one per extra core)
+// Parallel__shutdown() | Stop and join worker pool
+// Parallel__workers() | Count of threads that run chunks (incl. caller)
+// Parallel__for(range, grain, fn, userdata) | Run fn over chunks of range on all workers
+// Parallel__reduce(range, grain, fn, combine, identity, result, sz, userdata) | Parallel__for + combine()
+
+// usage:
+//   void Entity__tick(ParallelTask* t) {
+//     Entity* e = (Entity*)t->range.ptr;
+//     for (u32 i = 0; i < t->range.ct; i++) { ... }
+//   }
+//   Parallel__for(ARANGE2(entities), 0, Entity__tick, NULL);
+
+#define PARALLEL__STATE_RUNNING (1)
+
+// claim and run chunks of the current job until none remain
+static void _Parallel__exec(u32 w) {
+  ParallelWorker* worker = &parallel.workers[w];
+  Arena__reset(worker->scratch);
+  for (u32 c = Atomic__add(&parallel.next, 1); c < parallel.chunkCt;
+       c = Atomic__add(&parallel.next, 1)) {
+    u32 begin = c * parallel.grain;
+    u32 end = Math__min(begin + parallel.grain, parallel.range.ct);
+    ParallelTask task = {
+        .range =
+            {
+                .ct = end - begin,
+                .stride = parallel.range.stride,
+                .ptr = (u8*)parallel.range.ptr + (u64)begin * parallel.range.stride,
+            },
+        .begin = begin,
+        .end = end,
+        .worker = w,
+        .scratch = worker->scratch,
+        .acc = worker->acc,
+        .userdata = parallel.userdata,
+    };
+    parallel.fn(&task);
+    Atomic__add(&parallel.done, 1);
+  }
+}
+
+// join the published job, if it is new to this worker
+// @returns true if any work was attempted
+static bool _Parallel__join(u32 w) {
+  u32 state = Atomic__load(&parallel.state);
+  if (!(state & PARALLEL__STATE_RUNNING) || (state >> 1) == parallel.workers[w].lastGen) {
+    return false;
+  }
+  Atomic__add(&parallel.busy, 1);
+  Atomic__fence();  // pairs with fence in _Parallel__close()
+  if (state != Atomic__load(&parallel.state)) {
+    Atomic__sub(&parallel.busy, 1);  // job closed meanwhile
+    return false;
+  }
+  parallel.workers[w].lastGen = state >> 1;
+  _Parallel__exec(w);
+  Atomic__sub(&parallel.busy, 1);
+  return true;
+}
+
+// pool thread main loop
+THREAD_FN_RET _Parallel__worker(THREAD_FN_PARAM1 userdata) {
+  u32 w = (u32)(uintptr_t)userdata;
+  parallel.workers[w].scratch = ThreadCtx__get()->frameArena;  // owned by this thread
+  u32 idle = 0;
+  while (!Atomic__load(&parallel.quit)) {
+    if (_Parallel__join(w)) {
+      idle = 0;
+    } else if (idle < 64) {
+      Atomic__pause();
+      idle++;
+    } else if (idle < 1024) {
+      Thread__yield();
+      idle++;
+    } else if (Event__wait(&parallel.wake, 100)) {
+      u32 state = Atomic__load(&parallel.state);
+      bool fresh = (state & PARALLEL__STATE_RUNNING) && (state >> 1) != parallel.workers[w].lastGen;
+      if (fresh || Atomic__load(&parallel.quit)) {
+        Event__set(&parallel.wake);  // auto-reset; pass the wake-up on to the next sleeper
+      }
+      idle = 0;
+    }
+  }
+  return THREAD_FN_RET_VAL;
+}
+
+// Count of threads that run chunks (incl. caller)
+u32 Parallel__workers(void) {
+  return Math__max(1, parallel.workerCt);
+}
+
+// Start worker pool (0 = one per extra core)
+bool Parallel__init(u32 workerCt) {
+  if (0 == workerCt) {
+#ifdef __linux__
+    s64 cores = sysconf(_SC_NPROCESSORS_ONLN);
+    workerCt = cores > 1 ? (u32)cores - 1 : 0;
+#endif
+  }
+  workerCt = Math__min(workerCt, MAX_THREADS - 1);
+
+  parallel.quit = false;
+  parallel.state = 0;
+  parallel.wake = (Event){0};
+  parallel.workerCt = 1;
+  for (u32 w = 0; w <= workerCt; w++) {
+    parallel.workers[w].lastGen = 0;
+  }
+  // pool threads use their own ThreadCtx frame arena; the caller gets a dedicated one
+  parallel.workers[0].scratch = Arena__alloc(PARALLEL__SCRATCH_SZ);
+  if (NULL == parallel.workers[0].scratch) {
+    return false;
+  }
+  for (u32 w = 1; w <= workerCt; w++) {
+    if (!Thread__create(&parallel.threads[w], _Parallel__worker, (void*)(uintptr_t)w)) {
+      return false;
+    }
+    parallel.workerCt++;
+  }
+  return true;
+}
+
+// Stop and join worker pool
+void Parallel__shutdown(void) {
+  Atomic__store(&parallel.quit, true);
+  Event__set(&parallel.wake);
+  Thread__join(&parallel.threads[1], parallel.workerCt - 1);
+  Thread__destroy(&parallel.threads[1], parallel.workerCt - 1);
+  Arena__free(parallel.workers[0].scratch);
+  for (u32 w = 0; w < parallel.workerCt; w++) {
+    parallel.workers[w].scratch = NULL;
+  }
+  parallel.workerCt = 0;
+}
+
+// end the job; wait for stragglers so the next job may rewrite its fields
+static void _Parallel__close(void) {
+  Atomic__store(&parallel.state, Atomic__loadRelaxed(&parallel.state) & ~PARALLEL__STATE_RUNNING);
+  Atomic__fence();  // pairs with fence in _Parallel__join()
+  while (0 != Atomic__load(&parallel.busy)) {
+    Thread__yield();
+  }
+}
+
+// publish a job, help run it, and wait for completion
+static void _Parallel__run(ARange2 range, u32 grain, Parallel__fn_t fn, void* userdata) {
+  if (0 == grain) {
+    grain = range.stride > 0 ? Math__max(1, PARALLEL__CHUNK_SZ / range.stride) : 1024;
+  }
+  parallel.range = range;
+  parallel.grain = grain;
+  parallel.chunkCt = (range.ct + grain - 1) / grain;
+  parallel.fn = fn;
+  parallel.userdata = userdata;
+  parallel.next = 0;
+  parallel.done = 0;
+
+  u32 gen = (Atomic__loadRelaxed(&parallel.state) >> 1) + 1;
+  parallel.workers[0].lastGen = gen;
+  if (parallel.chunkCt > 1 && parallel.workerCt > 1) {
+    Atomic__store(&parallel.state, (gen << 1) | PARALLEL__STATE_RUNNING);
+    Event__set(&parallel.wake);
+  } else {
+    Atomic__store(&parallel.state, gen << 1);  // too small to share; run inline
+  }
+
+  _Parallel__exec(0);
+  while (Atomic__load(&parallel.done) < parallel.chunkCt) {
+    Thread__yield();
+  }
+  _Parallel__close();
+}
+
+// Run fn over chunks of range on all workers
+// grain = elements per chunk (0 = fit PARALLEL__CHUNK_SZ bytes)
+void Parallel__for(ARange2 range, u32 grain, Parallel__fn_t fn, void* userdata) {
+  ASSERT_CONTEXT(parallel.workerCt > 0, "Parallel__init() not called");
+  if (0 == range.ct) {
+    return;
+  }
+  _Parallel__run(range, grain, fn, userdata);
+}
+
+// Parallel__for, where each worker accumulates into task->acc (seeded from *identity),
+// then partials are folded into *result on the calling thread via combine()
+// *result keeps its initial value as the starting point, so it is counted exactly once
+void Parallel__reduce(
+    ARange2 range,
+    u32 grain,
+    Parallel__fn_t fn,
+    Parallel__combine_t combine,
+    const void* identity,
+    void* result,
+    u32 sz,
+    void* userdata) {
+  ASSERT_CONTEXT(parallel.workerCt > 0, "Parallel__init() not called");
+  ASSERT_CONTEXT(
+      sz <= PARALLEL__MAX_ACC_SZ,
+      "Reduce result too large. requested %u bytes, max %u bytes",
+      sz,
+      PARALLEL__MAX_ACC_SZ);
+  if (0 == range.ct) {
+    return;
+  }
+  for (u32 w = 0; w < parallel.workerCt; w++) {
+    memcpy(parallel.workers[w].acc, identity, sz);
+  }
+  _Parallel__run(range, grain, fn, userdata);
+  for (u32 w = 0; w < parallel.workerCt; w++) {
+    combine(result, parallel.workers[w].acc, userdata);
+  }
+}
\ No newline at end of file
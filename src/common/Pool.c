@@ -0,0 +1,189 @@
+#pragma once
+
+#include "../unity.h"  // IWYU pragma: keep
+
+// inspired by:
+// - [2013 Bob Nystrom - Game Programming Patterns: Object Pool](https://gameprogrammingpatterns.com/object-pool.html)
+// - [2001 Jeff Bonwick - Magazines and Vmem](https://www.usenix.org/legacy/event/usenix01/full_papers/bonwick/bonwick.pdf)
+
+// @class Pool
+// Function | Purpose
+// --- | ---
+// Pool__init(p, arena, slotSz, pageSlots) | Set up an empty pool (pageSlots 0 = POOL__PAGE_SLOTS)
+// Pool__alloc(p) | Take a slot (single owner; no locking)
+// Pool__free(p, ptr) | Give a slot back (single owner; no locking)
+// Pool__allocCached(p, c) | Take a slot via this thread's cache (shared pools)
+// Pool__freeCached(p, c, ptr) | Give a slot back via this thread's cache (shared pools)
+// Pool__flush(p, c) | Return every cached slot to the pool (thread exit)
+
+// @class Pool (generated by GENERIC_POOL_FNS)
+// Function | Purpose
+// --- | ---
+// N__init(p, arena, pageSlots) | Set up an empty pool of T
+// N__alloc(p) | Take a T (single owner)
+// N__free(p, item) | Give a T back (single owner)
+// N__allocCached(p, c) | Take a T via this thread's cache
+// N__freeCached(p, c, item) | Give a T back via this thread's cache
+
+// usage:
+//   GENERIC_POOL(BulletPool, Bullet);  // type (see unity.h)
+//   GENERIC_POOL_FNS(BulletPool, Bullet);  // functions
+//   BulletPool__init(&_G->bullets, _G->arena, 0);
+//   Bullet* b = BulletPool__alloc(&_G->bullets);
+//   BulletPool__free(&_G->bullets, b);
+//
+//   // shared between threads: each thread keeps its own cache
+//   static __thread PoolCache _bulletCache;
+//   Bullet* b = BulletPool__allocCached(&_G->bullets, &_bulletCache);
+//   Pool__flush(&_G->bullets.pool, &_bulletCache);  // before the thread exits
+
+// a pool is either single-owner (Pool__alloc/free) or shared (only *Cached + Pool__flush);
+// the arena must not be pushed to by anyone else while a shared pool may grow
+
+#define POOL__ALIGN (sizeof(void*))
+
+// carve one page of slots onto the free list (lowest address pops first)
+static bool _Pool__grow(Pool* p) {
+  u8* page = (u8*)Arena__pushAligned(p->arena, (u64)p->slotSz * p->pageSlots, POOL__ALIGN);
+  if (NULL == page) {
+    return false;
+  }
+  for (u32 i = p->pageSlots; i > 0; i--) {
+    Pool__Slot* s = (Pool__Slot*)(page + (u64)(i - 1) * p->slotSz);
+    s->next = p->free;
+    p->free = s;
+  }
+  p->carved += p->pageSlots;
+  return true;
+}
+
+// Set up an empty pool (pageSlots 0 = POOL__PAGE_SLOTS)
+// no memory is taken from the arena until the first alloc
+void Pool__init(Pool* p, Arena* arena, u32 slotSz, u32 pageSlots) {
+  memset(p, 0, sizeof(Pool));
+  p->arena = arena;
+  slotSz = slotSz < sizeof(Pool__Slot) ? sizeof(Pool__Slot) : slotSz;
+  p->slotSz = (u32)((slotSz + POOL__ALIGN - 1) & ~(POOL__ALIGN - 1));
+  p->pageSlots = 0 == pageSlots ? POOL__PAGE_SLOTS : pageSlots;
+}
+
+// Take a slot (single owner; no locking)
+// contents are whatever the last owner left; NULL when the arena is full
+void* Pool__alloc(Pool* p) {
+  if (NULL == p->free && !_Pool__grow(p)) {
+    return NULL;
+  }
+  Pool__Slot* s = p->free;
+  p->free = s->next;
+  p->live++;
+  return s;
+}
+
+// Give a slot back (single owner; no locking)
+void Pool__free(Pool* p, void* ptr) {
+  if (NULL == ptr) {
+    return;
+  }
+  ASSERT_CONTEXT(p->live > 0, "Pool__free() with no live slots (double free?)");
+  Pool__Slot* s = (Pool__Slot*)ptr;
+  s->next = p->free;
+  p->free = s;
+  p->live--;
+}
+
+// move up to ct slots from the cache back to the pool
+static void _Pool__drain(Pool* p, PoolCache* c, u32 ct) {
+  if (0 == ct || NULL == c->head) {
+    return;
+  }
+  Pool__Slot* first = c->head;
+  Pool__Slot* last = first;
+  u32 n = 1;
+  while (n < ct && NULL != last->next) {
+    last = last->next;
+    n++;
+  }
+  c->head = last->next;
+  c->ct -= n;
+  SyncMutex__lock(&p->lock);
+  last->next = p->free;  // splice the whole run in one step
+  p->free = first;
+  p->live -= n;
+  SyncMutex__unlock(&p->lock);
+}
+
+// Take a slot via this thread's cache (shared pools)
+// refills half a cache per lock, so threads touch the shared list once per ~32 allocs
+void* Pool__allocCached(Pool* p, PoolCache* c) {
+  if (NULL == c->head) {
+    SyncMutex__lock(&p->lock);
+    for (u32 i = 0; i < POOL__CACHE_CT / 2; i++) {
+      if (NULL == p->free && !_Pool__grow(p)) {
+        break;
+      }
+      Pool__Slot* s = p->free;
+      p->free = s->next;
+      s->next = c->head;
+      c->head = s;
+      c->ct++;
+      p->live++;
+    }
+    SyncMutex__unlock(&p->lock);
+    if (NULL == c->head) {
+      return NULL;
+    }
+  }
+  Pool__Slot* s = c->head;
+  c->head = s->next;
+  c->ct--;
+  return s;
+}
+
+// Give a slot back via this thread's cache (shared pools)
+// slots may be freed by a different thread than the one that allocated them
+void Pool__freeCached(Pool* p, PoolCache* c, void* ptr) {
+  if (NULL == ptr) {
+    return;
+  }
+  Pool__Slot* s = (Pool__Slot*)ptr;
+  s->next = c->head;
+  c->head = s;
+  c->ct++;
+  if (c->ct >= POOL__CACHE_CT) {
+    _Pool__drain(p, c, POOL__CACHE_CT / 2);  // keep half so alloc/free ping-pong stays local
+  }
+}
+
+// Return every cached slot to the pool (thread exit)
+void Pool__flush(Pool* p, PoolCache* c) {
+  _Pool__drain(p, c, c->ct);
+}
+
+// ---
+// Typed pool
+
+#define GENERIC_POOL_FNS(N, T)                                      \
+  /* Set up an empty pool of T */                                   \
+  static inline void N##__init(N* p, Arena* arena, u32 pageSlots) { \
+    Pool__init(&p->pool, arena, sizeof(T), pageSlots);              \
+  }                                                                 \
+                                                                    \
+  /* Take a T (single owner) */                                     \
+  static inline T* N##__alloc(N* p) {                               \
+    return (T*)Pool__alloc(&p->pool);                               \
+  }                                                                 \
+                                                                    \
+  /* Give a T back (single owner) */                                \
+  static inline void N##__free(N* p, T* item) {                     \
+    Pool__free(&p->pool, item);                                     \
+  }                                                                 \
+                                                                    \
+  /* Take a T via this thread's cache */                            \
+  static inline T* N##__allocCached(N* p, PoolCache* c) {           \
+    return (T*)Pool__allocCached(&p->pool, c);                      \
+  }                                                                 \
+                                                                    \
+  /* Give a T back via this thread's cache */                       \
+  static inline void N##__freeCached(N* p, PoolCache* c, T* item) { \
+    Pool__freeCached(&p->pool, c, item);                            \
+  }
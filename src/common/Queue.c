@@ -0,0 +1,211 @@
+#pragma once
+
+#include "../unity.h"  // IWYU pragma: keep
+
+// inspired by:
+// - [Dmitry Vyukov - Bounded MPMC queue](https://www.1024cores.net/home/lock-free-algorithms/queues/bounded-mpmc-queue)
+// - [Erik Rigtorp - Optimizing a ring buffer for throughput](https://rigtorp.se/ringbuffer/)
+
+// @class Spsc (generated by GENERIC_SPSC_FNS)
+// Function | Purpose
+// --- | ---
+// N__init(q) | Reset queue to empty
+// N__push(q, v) | Enqueue one item (producer thread only)
+// N__pop(q, out) | Dequeue one item (consumer thread only)
+// N__push_n(q, src, n) | Enqueue up to n items, return count pushed
+// N__pop_n(q, dst, n) | Dequeue up to n items, return count popped
+// N__len(q) | Approximate item count
+
+// @class Mpsc (generated by GENERIC_MPSC_FNS)
+// Function | Purpose
+// --- | ---
+// N__init(q) | Reset queue to empty
+// N__push(q, v) | Enqueue one item (any producer thread)
+// N__pop(q, out) | Dequeue one item (consumer thread only)
+// N__push_n(q, src, n) | Enqueue up to n items, return count pushed
+// N__pop_n(q, dst, n) | Dequeue up to n items, return count popped
+// N__len(q) | Approximate item count
+
+// usage:
+//   GENERIC_MPSC(MsgQueue, Msg*, 10);  // type; 1024 slots (see unity.h)
+//   GENERIC_MPSC_FNS(MsgQueue, Msg*, 10);  // functions
+//   MsgQueue* q = Arena__pushCacheline(_G->arena, sizeof(MsgQueue));  // owns its lines
+//   MsgQueue__init(q);
+
+// bound on CAS retries under producer contention (push reports failure; caller may retry)
+#define QUEUE__MAX_RETRY (1024)
+
+// ---
+// Spsc
+
+#define GENERIC_SPSC_FNS(N, T, CAP_LOG2)                                    \
+  /* Reset queue to empty */                                                \
+  static inline void N##__init(N* q) {                                      \
+    q->head = q->tailCache = 0;                                             \
+    q->tail = q->headCache = 0;                                             \
+  }                                                                         \
+                                                                            \
+  /* Enqueue one item (producer thread only) */                             \
+  static inline bool N##__push(N* q, T v) {                                 \
+    const u32 cap = 1u << (CAP_LOG2);                                       \
+    u32 head = Atomic__loadRelaxed(&q->head);                               \
+    if (head - q->tailCache == cap) {                                       \
+      q->tailCache = Atomic__load(&q->tail);                                \
+      if (head - q->tailCache == cap) {                                     \
+        return false; /* full */                                            \
+      }                                                                     \
+    }                                                                       \
+    q->buf[head & (cap - 1)] = v;                                           \
+    Atomic__store(&q->head, head + 1);                                      \
+    return true;                                                            \
+  }                                                                         \
+                                                                            \
+  /* Dequeue one item (consumer thread only) */                             \
+  static inline bool N##__pop(N* q, T* out) {                               \
+    const u32 cap = 1u << (CAP_LOG2);                                       \
+    u32 tail = Atomic__loadRelaxed(&q->tail);                               \
+    if (tail == q->headCache) {                                             \
+      q->headCache = Atomic__load(&q->head);                                \
+      if (tail == q->headCache) {                                           \
+        return false; /* empty */                                           \
+      }                                                                     \
+    }                                                                       \
+    *out = q->buf[tail & (cap - 1)];                                        \
+    Atomic__store(&q->tail, tail + 1);                                      \
+    return true;                                                            \
+  }                                                                         \
+                                                                            \
+  /* Enqueue up to n items, return count pushed (producer thread only) */   \
+  static inline u32 N##__push_n(N* q, const T* src, u32 n) {                \
+    const u32 cap = 1u << (CAP_LOG2);                                       \
+    u32 head = Atomic__loadRelaxed(&q->head);                               \
+    u32 free = cap - (head - q->tailCache);                                 \
+    if (free < n) {                                                         \
+      q->tailCache = Atomic__load(&q->tail);                                \
+      free = cap - (head - q->tailCache);                                   \
+    }                                                                       \
+    u32 ct = Math__min(n, free);                                            \
+    u32 i = head & (cap - 1);                                               \
+    u32 first = Math__min(ct, cap - i); /* split at wrap: max two copies */ \
+    memcpy(&q->buf[i], src, first * sizeof(T));                             \
+    memcpy(&q->buf[0], src + first, (ct - first) * sizeof(T));              \
+    Atomic__store(&q->head, head + ct);                                     \
+    return ct;                                                              \
+  }                                                                         \
+                                                                            \
+  /* Dequeue up to n items, return count popped (consumer thread only) */   \
+  static inline u32 N##__pop_n(N* q, T* dst, u32 n) {                       \
+    const u32 cap = 1u << (CAP_LOG2);                                       \
+    u32 tail = Atomic__loadRelaxed(&q->tail);                               \
+    u32 avail = q->headCache - tail;                                        \
+    if (avail < n) {                                                        \
+      q->headCache = Atomic__load(&q->head);                                \
+      avail = q->headCache - tail;                                          \
+    }                                                                       \
+    u32 ct = Math__min(n, avail);                                           \
+    u32 i = tail & (cap - 1);                                               \
+    u32 first = Math__min(ct, cap - i);                                     \
+    memcpy(dst, &q->buf[i], first * sizeof(T));                             \
+    memcpy(dst + first, &q->buf[0], (ct - first) * sizeof(T));              \
+    Atomic__store(&q->tail, tail + ct);                                     \
+    return ct;                                                              \
+  }                                                                         \
+                                                                            \
+  /* Approximate item count */                                              \
+  static inline u32 N##__len(N* q) {                                        \
+    return Atomic__load(&q->head) - Atomic__load(&q->tail);                 \
+  }
+
+// ---
+// Mpsc
+
+#define GENERIC_MPSC_FNS(N, T, CAP_LOG2)                                    \
+  /* Reset queue to empty */                                                \
+  static inline void N##__init(N* q) {                                      \
+    const u32 cap = 1u << (CAP_LOG2);                                       \
+    for (u32 i = 0; i < cap; i++) {                                         \
+      q->buf[i].seq = i;                                                    \
+    }                                                                       \
+    q->head = q->tail = 0;                                                  \
+  }                                                                         \
+                                                                            \
+  /* Enqueue one item (any producer thread) */                              \
+  static inline bool N##__push(N* q, T v) {                                 \
+    const u32 cap = 1u << (CAP_LOG2);                                       \
+    u32 pos = Atomic__loadRelaxed(&q->head);                                \
+    for (u32 r = 0; r < QUEUE__MAX_RETRY; r++) {                            \
+      N##__Cell* cell = &q->buf[pos & (cap - 1)];                           \
+      s32 dif = (s32)(Atomic__load(&cell->seq) - pos);                      \
+      if (0 == dif) {                                                       \
+        if (Atomic__cas(&q->head, &pos, pos + 1)) {                         \
+          cell->data = v;                                                   \
+          Atomic__store(&cell->seq, pos + 1); /* publish to consumer */     \
+          return true;                                                      \
+        }                                                                   \
+        /* lost the race; CAS reloaded pos */                               \
+      } else if (dif < 0) {                                                 \
+        return false; /* full */                                            \
+      } else {                                                              \
+        pos = Atomic__loadRelaxed(&q->head);                                \
+      }                                                                     \
+    }                                                                       \
+    return false; /* contended */                                           \
+  }                                                                         \
+                                                                            \
+  /* Dequeue one item (consumer thread only) */                             \
+  static inline bool N##__pop(N* q, T* out) {                               \
+    const u32 cap = 1u << (CAP_LOG2);                                       \
+    u32 pos = Atomic__loadRelaxed(&q->tail);                                \
+    N##__Cell* cell = &q->buf[pos & (cap - 1)];                             \
+    if ((s32)(Atomic__load(&cell->seq) - (pos + 1)) < 0) {                  \
+      return false; /* empty, or producer still writing */                  \
+    }                                                                       \
+    *out = cell->data;                                                      \
+    Atomic__store(&cell->seq, pos + cap); /* hand slot back to producers */ \
+    Atomic__store(&q->tail, pos + 1);                                       \
+    return true;                                                            \
+  }                                                                         \
+                                                                            \
+  /* Enqueue up to n items, return count pushed (any producer thread) */    \
+  static inline u32 N##__push_n(N* q, const T* src, u32 n) {                \
+    const u32 cap = 1u << (CAP_LOG2);                                       \
+    u32 pos = Atomic__loadRelaxed(&q->head);                                \
+    u32 ct = 0;                                                             \
+    for (u32 r = 0; r < QUEUE__MAX_RETRY; r++) {                            \
+      /* consumer frees slots in order, so tail bounds the free run */      \
+      u32 free = cap - (pos - Atomic__load(&q->tail));                      \
+      ct = Math__min(n, free);                                              \
+      if (0 == ct || Atomic__cas(&q->head, &pos, pos + ct)) {               \
+        break;                                                              \
+      }                                                                     \
+      ct = 0;                                                               \
+    }                                                                       \
+    for (u32 i = 0; i < ct; i++) {                                          \
+      N##__Cell* cell = &q->buf[(pos + i) & (cap - 1)];                     \
+      cell->data = src[i];                                                  \
+      Atomic__store(&cell->seq, pos + i + 1);                               \
+    }                                                                       \
+    return ct;                                                              \
+  }                                                                         \
+                                                                            \
+  /* Dequeue up to n items, return count popped (consumer thread only) */   \
+  static inline u32 N##__pop_n(N* q, T* dst, u32 n) {                       \
+    const u32 cap = 1u << (CAP_LOG2);                                       \
+    u32 pos = Atomic__loadRelaxed(&q->tail);                                \
+    u32 ct = 0;                                                             \
+    for (; ct < n && ct < cap; ct++) {                                      \
+      N##__Cell* cell = &q->buf[(pos + ct) & (cap - 1)];                    \
+      if ((s32)(Atomic__load(&cell->seq) - (pos + ct + 1)) < 0) {           \
+        break;                                                              \
+      }                                                                     \
+      dst[ct] = cell->data;                                                 \
+      Atomic__store(&cell->seq, pos + ct + cap);                            \
+    }                                                                       \
+    Atomic__store(&q->tail, pos + ct);                                      \
+    return ct;                                                              \
+  }                                                                         \
+                                                                            \
+  /* Approximate item count */                                              \
+  static inline u32 N##__len(N* q) {                                        \
+    return Atomic__load(&q->head) - Atomic__load(&q->tail);                 \
+  }
@@ -0,0 +1,322 @@
+#pragma once
+
+#include "../unity.h"  // IWYU pragma: keep
+
+// inspired by:
+// - [2014 Glenn Fiedler - Deterministic Lockstep](https://gafferongames.com/post/deterministic_lockstep/)
+// - [Google Protocol Buffers - Base 128 Varints](https://protobuf.dev/programming-guides/encoding/#varints)
+
+// @class Replay
+// Function | Purpose
+// --- | ---
+// Replay__open(r, path) | Start a recording session (appends to path)
+// Replay__close(r) | Flush + stop recording
+// Replay__beginTick(r) | Record _G->tick, _G->now, _G->seed (call at tick start)
+// Replay__recv(r, sock, buf, len) | Record bytes a connection delivered
+// Replay__closed(r, sock) | Record a connection closing
+// Replay__run(path, tick, stats) | Re-run recorded ticks headless, as fast as possible
+// Replay__printf(stats) | Print replay timing report
+
+// usage:
+//   // engine loop; order matters: replay delivers a tick's messages, then calls the tick fn
+//   _G->tick++;
+//   _G->now = Time__now();
+//   _G->seed = Time__perf_now();
+//   if (_G->replay) Replay__beginTick(_G->replay);
+//   Sock__read(...);  // per connection; recorded by Sock.c
+//   Game__tick();
+//
+//   // benchmark / bisect
+//   ReplayStats stats;
+//   Replay__run("match.tklg", Game__tick, &stats);
+//   Replay__printf(&stats);
+
+// NOTE: Fiber__read() consumes socket bytes directly (no onsockrecv), so fiber-driven input is
+// not recorded; replay covers the onsockrecv path only
+
+// file: u32 magic, u32 version, then records of u8 ReplayRecord + LEB128 varint fields.
+// host byte order (x86-64, ARM64, wasm are all little-endian)
+// every Replay__open() starts with a REPLAY_SESSION record, so runs appended to one file keep
+// their connection ids + ticks apart (both restart at 0 in a new process)
+
+GENERIC_HASHMAP_FNS(Replay__SocketMap, u64, Replay__Socket, Hash__u64, HASHMAP__EQ);
+
+// LEB128; up to 10 bytes for u64
+static u32 _Replay__putVarint(u8* out, u64 v) {
+  u32 n = 0;
+  while (v >= 0x80) {
+    out[n++] = (u8)v | 0x80;
+    v >>= 7;
+  }
+  out[n++] = (u8)v;
+  return n;
+}
+
+static bool _Replay__getVarint(const u8** p, const u8* end, u64* v) {
+  *v = 0;
+  for (u32 shift = 0; *p < end && shift < 64; shift += 7) {
+    u8 b = *(*p)++;
+    *v |= (u64)(b & 0x7f) << shift;
+    if (!(b & 0x80)) {
+      return true;
+    }
+  }
+  return false;  // truncated
+}
+
+static void _Replay__write(Replay* r, const void* buf, u32 len) {
+  r->bytes += File__write(buf, 1, len, r->file);
+}
+
+// Flush + stop recording
+void Replay__close(Replay* r) {
+  if (NULL != r->file) {
+    File__close(r->file);
+    r->file = NULL;
+  }
+}
+
+// Start a recording session (appends to path)
+// @returns false if path can't be opened, or holds a log of another format
+bool Replay__open(Replay* r, const char* path) {
+  r->bytes = 0;
+  if (0 != File__open(&r->file, path, "a+b")) {  // writes always append
+    return false;
+  }
+  fseek(r->file, 0, SEEK_END);
+  u32 header[2] = {REPLAY__MAGIC, REPLAY__VERSION};
+  if (0 == ftell(r->file)) {
+    _Replay__write(r, header, sizeof(header));
+  } else {
+    u32 existing[2] = {0};
+    fseek(r->file, 0, SEEK_SET);
+    if (1 != fread(existing, sizeof(existing), 1, r->file) ||
+        0 != memcmp(header, existing, sizeof(header))) {
+      Replay__close(r);
+      return false;  // never append v2 records to a v1 (or foreign) file
+    }
+  }
+  u8 rec[1 + 10];
+  u32 n = 0;
+  rec[n++] = REPLAY_SESSION;
+  n += _Replay__putVarint(rec + n, (u64)Time__unix_ts());
+  _Replay__write(r, rec, n);
+  return true;
+}
+
+// Record _G->tick, _G->now, _G->seed (call at tick start)
+void Replay__beginTick(Replay* r) {
+  u8 rec[1 + 10 * 3];
+  u32 n = 0;
+  rec[n++] = REPLAY_TICK;
+  n += _Replay__putVarint(rec + n, _G->tick);
+  n += _Replay__putVarint(rec + n, _G->now);
+  n += _Replay__putVarint(rec + n, _G->seed);
+  _Replay__write(r, rec, n);
+}
+
+// Record bytes a connection delivered
+void Replay__recv(Replay* r, Socket* sock, const u8* buf, u32 len) {
+  u8 rec[1 + 10 * 2];
+  u32 n = 0;
+  rec[n++] = REPLAY_RECV;
+  n += _Replay__putVarint(rec + n, sock->id);
+  n += _Replay__putVarint(rec + n, len);
+  _Replay__write(r, rec, n);
+  _Replay__write(r, buf, len);
+}
+
+// Record a connection closing
+void Replay__closed(Replay* r, Socket* sock) {
+  u8 rec[1 + 10];
+  u32 n = 0;
+  rec[n++] = REPLAY_CLOSE;
+  n += _Replay__putVarint(rec + n, sock->id);
+  _Replay__write(r, rec, n);
+}
+
+// ---
+// Replay driver
+
+// stand-in Socket for a recorded connection id
+// ids are keyed, not indexed, so a long-lived server's (or a corrupt) id costs one entry
+// @returns NULL if id can't be mapped (caller must treat the log as unreplayable)
+static Socket* _Replay__socket(Replay__SocketMap* m, u64 id) {
+  if (id > UINT32_MAX) {
+    return NULL;  // Socket.id is u32; corrupt record
+  }
+  Replay__Socket* rs = Replay__SocketMap__get(m, id);
+  if (NULL != rs) {
+    return rs->sock;
+  }
+  Replay__Socket s = {0};
+  if (NULL != _G->onsockalloc) {
+    _G->onsockalloc(&s.sock);  // same allocation path as a live accept
+  } else {
+    s.sock = (Socket*)calloc(1, sizeof(Socket));
+    s.owned = true;
+  }
+  if (NULL == s.sock) {
+    return NULL;
+  }
+  s.sock->id = (u32)id;
+  s.sock->replay = true;
+  s.sock->state = SOCKET_CONNECTED;
+  if (NULL == Replay__SocketMap__put(m, id, s)) {
+    if (s.owned) {
+      free(s.sock);
+    }
+    return NULL;  // id map out of reserve
+  }
+  return s.sock;
+}
+
+// end of a recorded process: its connections are gone, and the next session reuses ids
+static void _Replay__endSession(Replay__SocketMap* m) {
+  Replay__SocketMap__Entry* e;
+  for (u32 it = 0; NULL != (e = Replay__SocketMap__each(m, &it));) {
+    if (e->val.owned) {
+      free(e->val.sock);
+    } else {
+      e->val.sock->state = SOCKET_CLOSED;  // app-owned (onsockalloc); hand back as hung up
+      e->val.sock->sessionState = SESSION_SERVER_HUNGUP;
+    }
+  }
+  Replay__SocketMap__clear(m);
+}
+
+static void _Replay__endTick(Engine__tick_t tick, ReplayStats* stats, u64 start) {
+  tick();
+  u64 ns = Time__perf_now() - start;
+  stats->ticks++;
+  stats->totalNs += ns;
+  if (ns > stats->maxNs) {
+    stats->maxNs = ns;
+    stats->maxSession = stats->sessions;
+    stats->maxTick = _G->tick;
+  }
+}
+
+// Re-run recorded ticks headless, as fast as possible
+// the whole log is loaded up front, so tick times exclude file I/O
+// @returns false if the log is missing/corrupt, or a connection can't be mapped
+// (ticks before the damage still run)
+bool Replay__run(const char* path, Engine__tick_t tick, ReplayStats* stats) {
+  memset(stats, 0, sizeof(ReplayStats));
+  FILE* f;
+  if (0 != File__open(&f, path, "rb")) {
+    return false;
+  }
+  fseek(f, 0, SEEK_END);
+  s64 sz = ftell(f);
+  fseek(f, 0, SEEK_SET);
+  u8* data = sz > 0 ? (u8*)malloc(sz) : NULL;
+  u64 got = NULL != data ? File__read(data, sz, 1, sz, f) : 0;
+  File__close(f);
+  u32 header[2] = {0};
+  if (got >= sizeof(header)) {
+    memcpy(header, data, sizeof(header));
+  }
+  if (REPLAY__MAGIC != header[0] || REPLAY__VERSION != header[1]) {
+    free(data);
+    return false;
+  }
+
+  Arena* arena = Arena__reserve(REPLAY__ARENA_RESERVE, 0);
+  Replay__SocketMap socks;
+  if (NULL == arena || !Replay__SocketMap__init(&socks, arena, REPLAY__SOCKETS_MIN)) {
+    Arena__free(arena);
+    free(data);
+    return false;
+  }
+  Replay* recorder = _G->replay;
+  _G->replay = NULL;  // don't re-record what we replay
+
+  bool ok = true, pending = false;
+  u64 start = 0;
+  const u8* p = data + sizeof(header);
+  const u8* end = data + got;
+  while (ok && p < end) {
+    u8 kind = *p++;
+    u64 id, len;
+    if (REPLAY_TICK == kind) {
+      u64 t, now, seed;
+      ok = _Replay__getVarint(&p, end, &t) && _Replay__getVarint(&p, end, &now) &&
+           _Replay__getVarint(&p, end, &seed);
+      if (!ok) {
+        break;
+      }
+      if (pending) {
+        _Replay__endTick(tick, stats, start);
+      }
+      _G->tick = t;
+      _G->now = now;
+      _G->seed = seed;
+      pending = true;
+      start = Time__perf_now();
+    } else if (REPLAY_RECV == kind) {
+      ok = _Replay__getVarint(&p, end, &id) && _Replay__getVarint(&p, end, &len) &&
+           len <= (u64)(end - p);
+      Socket* sock = ok ? _Replay__socket(&socks, id) : NULL;
+      ok = ok && NULL != sock;
+      if (ok && NULL != _G->onsockrecv) {
+        _G->onsockrecv(sock, (u8*)p, (u32)len);
+        stats->msgs++;
+        stats->msgBytes += len;
+      }
+      p += ok ? len : 0;
+    } else if (REPLAY_SESSION == kind) {
+      u64 ts;
+      ok = _Replay__getVarint(&p, end, &ts);
+      if (!ok) {
+        break;
+      }
+      if (pending) {
+        _Replay__endTick(tick, stats, start);  // last tick of the previous session
+        pending = false;
+      }
+      _Replay__endSession(&socks);
+      stats->sessions++;
+    } else if (REPLAY_CLOSE == kind) {
+      ok = _Replay__getVarint(&p, end, &id);
+      Socket* sock = ok ? _Replay__socket(&socks, id) : NULL;
+      ok = ok && NULL != sock;
+      if (ok) {
+        sock->state = SOCKET_CLOSED;
+        sock->sessionState = SESSION_SERVER_HUNGUP;
+      }
+    } else {
+      ok = false;  // corrupt (or torn tail from a crash mid-record)
+    }
+  }
+  if (pending) {
+    _Replay__endTick(tick, stats, start);
+  }
+
+  _Replay__endSession(&socks);
+  Arena__free(arena);
+  free(data);
+  _G->replay = recorder;
+  return ok;
+}
+
+// Print replay timing report
+void Replay__printf(ReplayStats* stats) {
+  LOG_DEBUGF("\nReplay:");
+  LOG_DEBUGF(
+      "  %llu sessions, %llu ticks, %llu msgs (%llu bytes)",
+      (unsigned long long)stats->sessions,
+      (unsigned long long)stats->ticks,
+      (unsigned long long)stats->msgs,
+      (unsigned long long)stats->msgBytes);
+  if (0 == stats->ticks) {
+    return;
+  }
+  LOG_DEBUGF(
+      "  total %7.1lf ms  avg %7.1lf us  max %7.1lf us (session %llu tick %llu)",
+      stats->totalNs / 1e6,
+      stats->totalNs / 1e3 / stats->ticks,
+      stats->maxNs / 1e3,
+      (unsigned long long)stats->maxSession,
+      (unsigned long long)stats->maxTick);
+}
\ No newline at end of file
@@ -5,22 +5,22 @@
 // ---
 // Ring Buffer
 
-inline void Ring__clear(RingBuf* rb) {
+static inline void Ring__clear(RingBuf* rb) {
   rb->head = rb->tail;
 }
 
 // true if there are exactly zero valid items
-inline bool Ring__empty(RingBuf* rb) {
+static inline bool Ring__empty(RingBuf* rb) {
   return rb->head == rb->tail;
 }
 
 // true if every slot is occupied with a valid value
-inline bool Ring__full(RingBuf* rb, u16 cap) {
+static inline bool Ring__full(RingBuf* rb, u16 cap) {
   // NOTE: to disambiguate empty/full state, head is only allowed to decrement onto tail, not increment onto it
   return (rb->head + 1) % cap == rb->tail;
 }
 
-inline bool Ring__push(RingBuf* rb, u16 cap) {
+static inline bool Ring__push(RingBuf* rb, u16 cap) {
   if (Ring__full(rb, cap)) {
     return false;  // can't write
   }
@@ -28,7 +28,7 @@ inline bool Ring__push(RingBuf* rb, u16 cap) {
   return true;
 }
 
-inline bool Ring__pop(RingBuf* rb, u16 cap) {
+static inline bool Ring__pop(RingBuf* rb, u16 cap) {
   if (Ring__empty(rb)) {
     return false;  // can't read
   }
@@ -37,6 +37,99 @@ inline bool Ring__pop(RingBuf* rb, u16 cap) {
 }
 
 // convert offset to index
-inline u16 Ring__at(RingBuf* rb, u16 offset, u16 cap) {
+static inline u16 Ring__at(RingBuf* rb, u16 offset, u16 cap) {
   return (rb->tail + offset) % cap;
-}
\ No newline at end of file
+}
+
+// ---
+// Generic Ring
+
+// @class Ring (generated by GENERIC_RING_FNS)
+// Function | Purpose
+// --- | ---
+// N__init(r) | Reset ring to empty
+// N__len(r) | Item count
+// N__push(r, v) | Append one item; false if full
+// N__pushOver(r, v) | Append one item, dropping the oldest if full
+// N__pop(r, out) | Remove oldest item; false if empty
+// N__at(r, i) | Item i places after the oldest (i < len)
+// N__push_n(r, src, n) | Append up to n items, return count pushed
+// N__pop_n(r, dst, n) | Remove up to n oldest items, return count popped
+
+// usage:
+//   GENERIC_RING(InputRing, Input, 6);  // type; 64 slots (see unity.h)
+//   GENERIC_RING_FNS(InputRing, Input, 6);  // functions
+//   InputRing__pushOver(&client->history, input);  // keep the newest 64
+//   u32 ct = InputRing__pop_n(&client->inputs, batch, ARRAYSIZE(batch));
+
+// NOTE: single-threaded; see GENERIC_SPSC / GENERIC_MPSC (Queue.c) to cross threads
+
+#define GENERIC_RING_FNS(N, T, CAP_LOG2)                                    \
+  /* Reset ring to empty */                                                 \
+  static inline void N##__init(N* r) {                                      \
+    r->head = r->tail = 0;                                                  \
+  }                                                                         \
+                                                                            \
+  /* Item count */                                                          \
+  static inline u32 N##__len(N* r) {                                        \
+    return r->head - r->tail; /* exact across u32 wrap */                   \
+  }                                                                         \
+                                                                            \
+  /* Append one item; false if full */                                      \
+  static inline bool N##__push(N* r, T v) {                                 \
+    const u32 cap = 1u << (CAP_LOG2);                                       \
+    if (r->head - r->tail == cap) {                                         \
+      return false;                                                         \
+    }                                                                       \
+    r->buf[r->head++ & (cap - 1)] = v;                                      \
+    return true;                                                            \
+  }                                                                         \
+                                                                            \
+  /* Append one item, dropping the oldest if full */                        \
+  static inline void N##__pushOver(N* r, T v) {                             \
+    const u32 cap = 1u << (CAP_LOG2);                                       \
+    if (r->head - r->tail == cap) {                                         \
+      r->tail++;                                                            \
+    }                                                                       \
+    r->buf[r->head++ & (cap - 1)] = v;                                      \
+  }                                                                         \
+                                                                            \
+  /* Remove oldest item; false if empty */                                  \
+  static inline bool N##__pop(N* r, T* out) {                               \
+    const u32 cap = 1u << (CAP_LOG2);                                       \
+    if (r->head == r->tail) {                                               \
+      return false;                                                         \
+    }                                                                       \
+    *out = r->buf[r->tail++ & (cap - 1)];                                   \
+    return true;                                                            \
+  }                                                                         \
+                                                                            \
+  /* Item i places after the oldest (i < len) */                            \
+  static inline T* N##__at(N* r, u32 i) {                                   \
+    ASSERT_CONTEXT(i < r->head - r->tail, "Ring index %u out of range", i); \
+    return &r->buf[(r->tail + i) & ((1u << (CAP_LOG2)) - 1)];               \
+  }                                                                         \
+                                                                            \
+  /* Append up to n items, return count pushed */                           \
+  static inline u32 N##__push_n(N* r, const T* src, u32 n) {                \
+    const u32 cap = 1u << (CAP_LOG2);                                       \
+    u32 ct = Math__min(n, cap - (r->head - r->tail));                       \
+    u32 i = r->head & (cap - 1);                                            \
+    u32 first = Math__min(ct, cap - i); /* split at wrap: max two copies */ \
+    memcpy(&r->buf[i], src, first * sizeof(T));                             \
+    memcpy(&r->buf[0], src + first, (ct - first) * sizeof(T));              \
+    r->head += ct;                                                          \
+    return ct;                                                              \
+  }                                                                         \
+                                                                            \
+  /* Remove up to n oldest items, return count popped */                    \
+  static inline u32 N##__pop_n(N* r, T* dst, u32 n) {                       \
+    const u32 cap = 1u << (CAP_LOG2);                                       \
+    u32 ct = Math__min(n, r->head - r->tail);                               \
+    u32 i = r->tail & (cap - 1);                                            \
+    u32 first = Math__min(ct, cap - i);                                     \
+    memcpy(dst, &r->buf[i], first * sizeof(T));                             \
+    memcpy(dst + first, &r->buf[0], (ct - first) * sizeof(T));              \
+    r->tail += ct;                                                          \
+    return ct;                                                              \
+  }
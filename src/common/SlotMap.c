@@ -0,0 +1,103 @@
+#pragma once
+
+#include "../unity.h"  // IWYU pragma: keep
+
+// inspired by:
+// - [2017 Allan Deutsch - C++Now: The Slot Map Data Structure](https://www.youtube.com/watch?v=SHaAR7XPtNU)
+// - [2018 Andre Weissflog - Handles are the better pointers](https://floooh.github.io/2018/06/17/handles-vs-pointers.html)
+
+// @class SlotMap (generated by GENERIC_SLOTMAP_FNS)
+// Function | Purpose
+// --- | ---
+// N__init(m, arena, cap) | Allocate storage for up to cap items
+// N__insert(m, v) | Add item, return its handle (null handle when full)
+// N__get(m, h) | Item for handle, or NULL if removed/stale
+// N__has(m, h) | Is handle still live?
+// N__remove(m, h) | Remove item; O(1) (last item moves into the hole)
+// N__handleAt(m, i) | Handle of dense item i (while iterating)
+// N__clear(m) | Remove all items; every outstanding handle goes stale
+
+// usage:
+//   GENERIC_SLOTMAP(Clients, Client);  // type (see unity.h)
+//   GENERIC_SLOTMAP_FNS(Clients, Client);  // functions
+//   Clients__init(&_G->clients, _G->arena, 1024);
+//   SlotHandle h = Clients__insert(&_G->clients, (Client){.sock = sock});
+//   Client* c = Clients__get(&_G->clients, h);  // NULL once removed; never dangling
+//
+//   // per tick: linear sweep, no pointer chasing
+//   for (u32 i = 0; i < _G->clients.len; i++) Client__tick(&_G->clients.dense[i]);
+
+// NOTE: remove() moves the last item, so pointers from get() are only good until the next
+// insert/remove; hold the SlotHandle instead
+
+#define GENERIC_SLOTMAP_FNS(N, T)                                           \
+  /* Allocate storage for up to cap items */                                \
+  static inline bool N##__init(N* m, Arena* arena, u32 cap) {               \
+    m->dense = Arena__pushArray(arena, T, cap);                             \
+    m->denseSlot = Arena__pushArray(arena, u32, cap);                       \
+    m->slots = Arena__pushArray(arena, SlotMap__Slot, cap);                 \
+    m->len = m->slotCt = 0;                                                 \
+    m->cap = cap;                                                           \
+    m->freeHead = SLOTMAP__NONE;                                            \
+    return NULL != m->dense && NULL != m->denseSlot && NULL != m->slots;    \
+  }                                                                         \
+                                                                            \
+  /* Add item, return its handle (null handle when full) */                 \
+  static inline SlotHandle N##__insert(N* m, T v) {                         \
+    u32 s;                                                                  \
+    if (SLOTMAP__NONE != m->freeHead) {                                     \
+      s = m->freeHead;                                                      \
+      m->freeHead = m->slots[s].idx;                                        \
+    } else if (m->slotCt < m->cap) {                                        \
+      s = m->slotCt++;                                                      \
+      m->slots[s].gen = 1;                                                  \
+    } else {                                                                \
+      return (SlotHandle){0}; /* full */                                    \
+    }                                                                       \
+    m->slots[s].idx = m->len;                                               \
+    m->denseSlot[m->len] = s;                                               \
+    m->dense[m->len++] = v;                                                 \
+    return (SlotHandle){.idx = s, .gen = m->slots[s].gen};                  \
+  }                                                                         \
+                                                                            \
+  /* Is handle still live? */                                               \
+  static inline bool N##__has(N* m, SlotHandle h) {                         \
+    return h.idx < m->slotCt && 0 != h.gen && h.gen == m->slots[h.idx].gen; \
+  }                                                                         \
+                                                                            \
+  /* Item for handle, or NULL if removed/stale */                           \
+  static inline T* N##__get(N* m, SlotHandle h) {                           \
+    return N##__has(m, h) ? &m->dense[m->slots[h.idx].idx] : NULL;          \
+  }                                                                         \
+                                                                            \
+  /* Remove item; O(1) (last item moves into the hole) */                   \
+  static inline bool N##__remove(N* m, SlotHandle h) {                      \
+    if (!N##__has(m, h)) {                                                  \
+      return false;                                                         \
+    }                                                                       \
+    u32 hole = m->slots[h.idx].idx;                                         \
+    u32 last = --m->len;                                                    \
+    if (hole != last) {                                                     \
+      m->dense[hole] = m->dense[last];                                      \
+      m->denseSlot[hole] = m->denseSlot[last];                              \
+      m->slots[m->denseSlot[hole]].idx = hole;                              \
+    }                                                                       \
+    SlotMap__Slot* slot = &m->slots[h.idx];                                 \
+    slot->gen = 0 == slot->gen + 1 ? 1 : slot->gen + 1; /* 0 stays null */  \
+    slot->idx = m->freeHead;                                                \
+    m->freeHead = h.idx;                                                    \
+    return true;                                                            \
+  }                                                                         \
+                                                                            \
+  /* Handle of dense item i (while iterating) */                            \
+  static inline SlotHandle N##__handleAt(N* m, u32 i) {                     \
+    u32 s = m->denseSlot[i];                                                \
+    return (SlotHandle){.idx = s, .gen = m->slots[s].gen};                  \
+  }                                                                         \
+                                                                            \
+  /* Remove all items; every outstanding handle goes stale */               \
+  static inline void N##__clear(N* m) {                                     \
+    while (m->len > 0) {                                                    \
+      N##__remove(m, N##__handleAt(m, m->len - 1));                         \
+    }                                                                       \
+  }
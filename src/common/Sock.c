@@ -19,6 +19,16 @@
 // Sock__free(socket) | Free socket resources
 // Sock__destroy() | Perform global socket cleanup
 
+static u32 _Sock__nextId = 0;
+
+// deliver received bytes to the engine (and the replay log, when recording)
+static void _Sock__recv(Socket* socket, u8* buf, u32 len) {
+  if (NULL != _G->replay) {
+    Replay__recv(_G->replay, socket, buf, len);
+  }
+  _G->onsockrecv(socket, buf, len);
+}
+
 // Set socket to non-blocking i/o mode
 void Sock__async(Socket* socket) {
 #ifdef __linux__
@@ -62,6 +72,12 @@ void Sock__close(Socket* socket) {
   socket->sessionState = SESSION_SERVER_HUNGUP;
 
   LOG_DEBUGF("Setting socket closed %s:%s", socket->addr, socket->port);
+  if (NULL != _G->replay) {
+    Replay__closed(_G->replay, socket);
+  }
+  if (socket->replay) {
+    return;  // no OS socket behind it
+  }
 
 #ifdef __linux__
   close(socket->_nix_socket);
@@ -178,6 +194,7 @@ Module.__libwebsocket = libwebsocket;
 
 // per-Socket initialization
 void Sock__init(Socket* sock, char* addr, char* port, SocketOpts opts) {
+  sock->id = ++_Sock__nextId;
   memcpy(sock->addr, addr, strlen(addr) + 1);
   memcpy(sock->port, port, strlen(port) + 1);
 
@@ -364,6 +381,7 @@ void Sock__accept(Socket* socket) {
 // server is not be hosted in wasm.
 #endif
 
+  csocket->id = ++_Sock__nextId;
   csocket->state = SOCKET_CONNECTED;
   _G->onsockaccept(socket, csocket);
 }
@@ -456,7 +474,7 @@ s8 Sock__read(Socket* socket, u32 len) {
   // Read data from the client socket
   int bytesRead = read(socket->_nix_socket, buf, len);
   if (bytesRead > 0) {
-    _G->onsockrecv(socket, buf, bytesRead);
+    _Sock__recv(socket, buf, bytesRead);
     return 1;  // successful read
   }
   if (-1 == bytesRead) {
@@ -487,7 +505,7 @@ s8 Sock__read(Socket* socket, u32 len) {
       LOG_DEBUGF("requested to read %d got %d", len, bytesRead);
     }
     if (bytesRead > 0) {
-      _G->onsockrecv(socket, buf, bytesRead);
+      _Sock__recv(socket, buf, bytesRead);
       return 1;  //successful read
     }
 
@@ -525,6 +543,10 @@ s8 Sock__write(Socket* socket, u8* buf, u32 len) {
   if (SOCKET_CLOSED == socket->state) {
     return -1;  // cannot write
   }
+  if (socket->replay) {
+    _G->onsocksend(socket, buf, len);  // headless replay; run the handler, skip the OS
+    return 1;
+  }
 
 #ifdef __linux__
   int bytesWritten = send(socket->_nix_socket, buf, len, 0);
@@ -642,7 +664,7 @@ int EMSCRIPTEN_KEEPALIVE libwebsocket_cb(
   }
 
   else if (WS_CLIENT_RECEIVE == callbackFnId) {
-    _G->onsockrecv(socket, data, len);
+    _Sock__recv(socket, data, len);
   }
 
   // if (reason == WS_WSI_DESTROY) {
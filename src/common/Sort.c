@@ -0,0 +1,227 @@
+#pragma once
+
+#include "../unity.h"  // IWYU pragma: keep
+
+// inspired by:
+// - [1997 David Musser - Introspective Sorting and Selection Algorithms](https://www.cs.rpi.edu/~musser/gp/introsort.ps)
+// - [2000 Michael Herf - Radix Tricks](http://stereopsis.com/radix.html)
+
+// @class Sort (generated by GENERIC_SORT_FNS)
+// Function | Purpose
+// --- | ---
+// N__sort(a, n) | Introsort in place by LESS (not stable)
+// N__sortRange(r) | N__sort over an ARange
+
+// @class Radix (generated by GENERIC_RADIX_FNS)
+// Function | Purpose
+// --- | ---
+// N__radix(a, n, arena) | LSD radix sort in place by KEY (ascending, stable)
+// N__radixRange(r, arena) | N__radix over an ARange
+
+// @class Sort keys
+// Function | Purpose
+// --- | ---
+// Sort__keyU32(x) / Sort__keyU64(x) | Unsigned key (as is)
+// Sort__keyS32(x) / Sort__keyS64(x) | Signed -> unsigned with the same order
+// Sort__keyF32(f) / Sort__keyF64(f) | Float -> unsigned with the same order (-0 < +0; NaN last)
+
+// usage:
+//   #define Snap__less(a, b) ((a).prio > (b).prio)  // highest priority first
+//   #define Snap__key(s) (~Sort__keyF32((s).prio))  // same order as a radix key
+//   GENERIC_SORT_FNS(Snaps, Snap, Snap__less);
+//   GENERIC_RADIX_FNS(SnapsR, Snap, u32, Snap__key);
+//   Snaps__sort(snaps, ct);  // any key; comparison inlined
+//   SnapsR__radix(snaps, ct, _G->frameArena);  // numeric keys; O(n); scratch freed on return
+
+#define SORT__INSERTION_MAX (16)  // runs this short finish with insertion sort
+#define SORT__LESS(a, b) ((a) < (b))
+
+// ---
+// Keys
+
+#define Sort__keyU32(x) ((u32)(x))
+#define Sort__keyU64(x) ((u64)(x))
+#define Sort__keyS32(x) ((u32)(x) ^ 0x80000000u)
+#define Sort__keyS64(x) ((u64)(x) ^ 0x8000000000000000ull)
+
+// Float -> unsigned with the same order: flip all bits of negatives, only the sign of positives
+static inline u32 Sort__keyF32(f32 f) {
+  u32 b;
+  memcpy(&b, &f, sizeof(b));
+  return (b & 0x80000000u) ? ~b : b | 0x80000000u;
+}
+
+// Float -> unsigned with the same order (f64)
+static inline u64 Sort__keyF64(f64 f) {
+  u64 b;
+  memcpy(&b, &f, sizeof(b));
+  return (b & 0x8000000000000000ull) ? ~b : b | 0x8000000000000000ull;
+}
+
+// ---
+// Introsort
+
+#define GENERIC_SORT_FNS(N, T, LESS)                                                     \
+  /* insertion sort; fastest for short runs */                                           \
+  static inline void _##N##__insertion(T* a, u32 n) {                                    \
+    for (u32 i = 1; i < n; i++) {                                                        \
+      T x = a[i];                                                                        \
+      u32 j = i;                                                                         \
+      while (j > 0 && LESS(x, a[j - 1])) {                                               \
+        a[j] = a[j - 1];                                                                 \
+        j--;                                                                             \
+      }                                                                                  \
+      a[j] = x;                                                                          \
+    }                                                                                    \
+  }                                                                                      \
+                                                                                         \
+  /* max-heap sift for heapsort */                                                       \
+  static inline void _##N##__siftDown(T* a, u32 i, u32 n) {                              \
+    T x = a[i];                                                                          \
+    for (;;) {                                                                           \
+      u32 c = 2 * i + 1;                                                                 \
+      if (c >= n) {                                                                      \
+        break;                                                                           \
+      }                                                                                  \
+      if (c + 1 < n && LESS(a[c], a[c + 1])) {                                           \
+        c++;                                                                             \
+      }                                                                                  \
+      if (!(LESS(x, a[c]))) {                                                            \
+        break;                                                                           \
+      }                                                                                  \
+      a[i] = a[c];                                                                       \
+      i = c;                                                                             \
+    }                                                                                    \
+    a[i] = x;                                                                            \
+  }                                                                                      \
+                                                                                         \
+  /* heapsort; caps the worst case at O(n log n) when partitions keep going bad */       \
+  static inline void _##N##__heapsort(T* a, u32 n) {                                     \
+    for (u32 i = n / 2; i-- > 0;) {                                                      \
+      _##N##__siftDown(a, i, n);                                                         \
+    }                                                                                    \
+    for (u32 end = n - 1; end > 0; end--) {                                              \
+      T t = a[0];                                                                        \
+      a[0] = a[end];                                                                     \
+      a[end] = t;                                                                        \
+      _##N##__siftDown(a, 0, end);                                                       \
+    }                                                                                    \
+  }                                                                                      \
+                                                                                         \
+  /* order a[i] <= a[j] */                                                               \
+  static inline void _##N##__order(T* a, u32 i, u32 j) {                                 \
+    if (LESS(a[j], a[i])) {                                                              \
+      T t = a[i];                                                                        \
+      a[i] = a[j];                                                                       \
+      a[j] = t;                                                                          \
+    }                                                                                    \
+  }                                                                                      \
+                                                                                         \
+  /* quicksort until depth runs out; short runs are left to insertion sort */            \
+  static inline void _##N##__intro(T* a, u32 n, u32 depth) {                             \
+    while (n > SORT__INSERTION_MAX) {                                                    \
+      if (0 == depth--) {                                                                \
+        _##N##__heapsort(a, n);                                                          \
+        return;                                                                          \
+      }                                                                                  \
+      /* median of three; a[0] and a[n - 1] then bound both scans */                     \
+      u32 m = n / 2;                                                                     \
+      _##N##__order(a, 0, m);                                                            \
+      _##N##__order(a, m, n - 1);                                                        \
+      _##N##__order(a, 0, m);                                                            \
+      T pivot = a[m];                                                                    \
+      u32 i = 0, j = n - 1;                                                              \
+      for (;;) {                                                                         \
+        do {                                                                             \
+          i++;                                                                           \
+        } while (LESS(a[i], pivot));                                                     \
+        do {                                                                             \
+          j--;                                                                           \
+        } while (LESS(pivot, a[j]));                                                     \
+        if (i >= j) {                                                                    \
+          break;                                                                         \
+        }                                                                                \
+        T t = a[i];                                                                      \
+        a[i] = a[j];                                                                     \
+        a[j] = t;                                                                        \
+      }                                                                                  \
+      /* [0, i) <= pivot <= [i, n); recurse into the smaller side, loop on the larger */ \
+      if (i < n - i) {                                                                   \
+        _##N##__intro(a, i, depth);                                                      \
+        a += i;                                                                          \
+        n -= i;                                                                          \
+      } else {                                                                           \
+        _##N##__intro(a + i, n - i, depth);                                              \
+        n = i;                                                                           \
+      }                                                                                  \
+    }                                                                                    \
+    _##N##__insertion(a, n);                                                             \
+  }                                                                                      \
+                                                                                         \
+  /* Introsort in place by LESS (not stable) */                                          \
+  static inline void N##__sort(T* a, u32 n) {                                            \
+    u32 depth = 0;                                                                       \
+    for (u32 k = n; k > 1; k >>= 1) {                                                    \
+      depth += 2; /* 2 * log2(n) bad splits before falling back to heapsort */           \
+    }                                                                                    \
+    _##N##__intro(a, n, depth);                                                          \
+  }                                                                                      \
+                                                                                         \
+  /* N__sort over an ARange */                                                           \
+  static inline void N##__sortRange(ARange r) {                                          \
+    N##__sort((T*)r.ptr, r.ct);                                                          \
+  }
+
+// ---
+// Radix
+
+#define GENERIC_RADIX_FNS(N, T, K, KEY)                                             \
+  /* LSD radix sort in place by KEY (ascending, stable) */                          \
+  /* K = u32 or u64 key type; one pass per byte, skipping bytes every key shares */ \
+  /* @returns false if arena can't fit the scratch copy (a is untouched) */         \
+  static inline bool N##__radix(T* a, u32 n, Arena* arena) {                        \
+    if (n < 2) {                                                                    \
+      return true;                                                                  \
+    }                                                                               \
+    ArenaTemp tmp = ArenaTemp__begin(arena);                                        \
+    T* buf = Arena__pushArray(arena, T, n);                                         \
+    u32* hist = Arena__pushArrayZ(arena, u32, sizeof(K) * 256);                     \
+    if (NULL == buf || NULL == hist) {                                              \
+      ArenaTemp__end(tmp);                                                          \
+      return false;                                                                 \
+    }                                                                               \
+    for (u32 i = 0; i < n; i++) { /* every byte's histogram in one read */          \
+      K k = KEY(a[i]);                                                              \
+      for (u32 d = 0; d < sizeof(K); d++) {                                         \
+        hist[d * 256 + (u32)((k >> (d * 8)) & 0xff)]++;                             \
+      }                                                                             \
+    }                                                                               \
+    T *src = a, *dst = buf;                                                         \
+    for (u32 d = 0; d < sizeof(K); d++) {                                           \
+      u32* h = &hist[d * 256];                                                      \
+      if (n == h[(u32)((KEY(src[0]) >> (d * 8)) & 0xff)]) {                         \
+        continue;                                                                   \
+      }                                                                             \
+      for (u32 b = 0, sum = 0; b < 256; b++) { /* counts -> start offsets */        \
+        u32 c = h[b];                                                               \
+        h[b] = sum;                                                                 \
+        sum += c;                                                                   \
+      }                                                                             \
+      for (u32 i = 0; i < n; i++) {                                                 \
+        dst[h[(u32)((KEY(src[i]) >> (d * 8)) & 0xff)]++] = src[i];                  \
+      }                                                                             \
+      T* t = src;                                                                   \
+      src = dst;                                                                    \
+      dst = t;                                                                      \
+    }                                                                               \
+    if (src != a) {                                                                 \
+      memcpy(a, src, (u64)n * sizeof(T));                                           \
+    }                                                                               \
+    ArenaTemp__end(tmp);                                                            \
+    return true;                                                                    \
+  }                                                                                 \
+                                                                                    \
+  /* N__radix over an ARange */                                                     \
+  static inline bool N##__radixRange(ARange r, Arena* arena) {                      \
+    return N##__radix((T*)r.ptr, r.ct, arena);                                      \
+  }
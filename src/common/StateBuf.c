@@ -0,0 +1,115 @@
+#pragma once
+
+#include "../unity.h"  // IWYU pragma: keep
+
+// inspired by:
+// - [2013 Jeff Preshing - Acquire and Release Semantics](https://preshing.com/20120913/acquire-and-release-semantics/)
+// - [2004 Maged Michael - Hazard Pointers](https://www.cs.otago.ac.nz/cosc440/readings/hazard-pointers.pdf)
+
+// @class StateBuf
+// Function | Purpose
+// --- | ---
+// StateBuf__init(sb, arena, sz, ct) | Allocate ct buffers of sz bytes (ct 2..STATEBUF__MAX_CT)
+// StateBuf__begin(sb, copyForward) | Writer: get a back buffer (waits while readers pin them all)
+// StateBuf__publish(sb) | Writer: make the back buffer the latest version
+// StateBuf__version(sb) | Latest published version (0 = none yet)
+// StateBuf__acquire(sb) | Reader: pin the latest published buffer
+// StateBuf__release(sb, view) | Reader: unpin; buffer may be rewritten after this
+
+// usage:
+//   // sim thread, once per tick
+//   World* w = StateBuf__begin(&_G->world, true);  // starts as a copy of last tick
+//   World__tick(w);
+//   StateBuf__publish(&_G->world);
+//
+//   // any net thread, any time
+//   StateView v = StateBuf__acquire(&_G->world);
+//   if (v.data) Snapshot__encode((const World*)v.data, v.version);
+//   StateBuf__release(&_G->world, v);
+
+#define STATEBUF__NONE (UINT32_MAX)
+
+// Allocate ct buffers of sz bytes (ct 2..STATEBUF__MAX_CT)
+// 2 = double buffer: begin() spins, unbounded, until a reader releases the previous tick
+// 3 = triple buffer: the writer never waits unless readers hold views across two publishes
+void StateBuf__init(StateBuf* sb, Arena* arena, u32 sz, u32 ct) {
+  ASSERT_CONTEXT(
+      ct >= 2 && ct <= STATEBUF__MAX_CT,
+      "StateBuf needs 2..%u buffers, got %u",
+      STATEBUF__MAX_CT,
+      ct);
+  memset(sb, 0, sizeof(StateBuf));
+  sb->ct = ct;
+  sb->sz = sz;
+  sb->writing = STATEBUF__NONE;
+  for (u32 i = 0; i < ct; i++) {
+    sb->bufs[i] = (u8*)Arena__pushCacheline(arena, sz);  // writer + readers never share a line
+  }
+}
+
+// Writer: get a back buffer to fill for the next tick
+// copyForward = start from the last published state (incremental updates)
+void* StateBuf__begin(StateBuf* sb, bool copyForward) {
+  ASSERT_CONTEXT(STATEBUF__NONE == sb->writing, "StateBuf__begin() twice without publish()");
+  u32 pub = sb->published;  // only the writer changes it
+  for (u32 spin = 0;; spin++) {
+    // pairs with fence in StateBuf__acquire(): either we see the reader's ref,
+    // or the reader sees that its buffer is no longer published and backs off
+    Atomic__fence();
+    for (u32 i = 0; i < sb->ct; i++) {
+      if (i != pub && 0 == Atomic__load(&sb->refs[i].refs)) {
+        sb->writing = i;
+        if (copyForward && 0 != sb->versions[pub]) {
+          memcpy(sb->bufs[i], sb->bufs[pub], sb->sz);
+        }
+        return sb->bufs[i];
+      }
+    }
+    if (0 == spin) {
+      sb->stalls++;  // every back buffer pinned; add a buffer or shorten reader holds
+    }
+    Thread__yield();
+  }
+}
+
+// Writer: make the back buffer the latest version
+// @returns the new version
+u64 StateBuf__publish(StateBuf* sb) {
+  ASSERT_CONTEXT(STATEBUF__NONE != sb->writing, "StateBuf__publish() without begin()");
+  u32 w = sb->writing;
+  sb->versions[w] = sb->version + 1;
+  Atomic__store(&sb->published, w);  // release: buffer contents + version visible first
+  Atomic__store(&sb->version, sb->versions[w]);
+  sb->writing = STATEBUF__NONE;
+  return sb->versions[w];
+}
+
+// Latest published version (0 = none yet)
+// cheap check so readers can skip work when nothing changed
+u64 StateBuf__version(StateBuf* sb) {
+  return Atomic__load(&sb->version);
+}
+
+// Reader: pin the latest published buffer
+// data is NULL until the first publish; never blocks the writer
+StateView StateBuf__acquire(StateBuf* sb) {
+  for (;;) {
+    u32 idx = Atomic__load(&sb->published);
+    Atomic__add(&sb->refs[idx].refs, 1);
+    Atomic__fence();  // pairs with fence in StateBuf__begin()
+    if (idx == Atomic__load(&sb->published)) {
+      u64 version = sb->versions[idx];
+      return (StateView){
+          .data = 0 != version ? sb->bufs[idx] : NULL,
+          .version = version,
+          .idx = idx,
+      };
+    }
+    Atomic__sub(&sb->refs[idx].refs, 1);  // writer published meanwhile; retry on the newer one
+  }
+}
+
+// Reader: unpin; buffer may be rewritten after this
+void StateBuf__release(StateBuf* sb, StateView view) {
+  Atomic__sub(&sb->refs[view.idx].refs, 1);  // release: our reads finish before writer reuse
+}
\ No newline at end of file
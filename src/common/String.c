@@ -93,37 +93,51 @@ Str8 Str8__stack() {
   };
 }
 
-// concatenate to arena (heap)
-void Str8__cat(Str8* dst, u32 ct, ...) {
+// concatenate ct Str8* into arena
+static void _Str8__vcat(Arena* arena, Str8* dst, u32 ct, va_list args) {
   dst->len = 0;
   dst->life = STR_ARENA1;
   dst->mut = true;
   dst->slice = false;
   dst->str = NULL;
 
-  va_list args;
-  va_start(args, ct);
+  va_list again;
+  va_copy(again, args);
   for (u32 i = 0; i < ct; i++) {
     Str8* s = va_arg(args, Str8*);
     Str8__init(s);
     dst->len += s->len;
   }
-  va_end(args);
 
-  dst->str = (char*)Arena__push(_G->arena, dst->len + 1);
+  dst->str = (char*)Arena__push(arena, dst->len + 1);
   char* p = dst->str;
 
-  va_start(args, ct);
   for (u32 i = 0; i < ct; i++) {
-    Str8* s = va_arg(args, Str8*);
+    Str8* s = va_arg(again, Str8*);
     memcpy(p, s->str, s->len);
     p += s->len;
   }
-  va_end(args);
+  va_end(again);
 
   *p = 0;  // null-terminate (for convenience)
 }
 
+// concatenate to calling thread's arena (heap)
+void Str8__cat(Str8* dst, u32 ct, ...) {
+  va_list args;
+  va_start(args, ct);
+  _Str8__vcat(ThreadCtx__get()->arena, dst, ct, args);
+  va_end(args);
+}
+
+// concatenate to a given arena (ie. Scratch__begin() for temporaries)
+void Str8__catTo(Arena* arena, Str8* dst, u32 ct, ...) {
+  va_list args;
+  va_start(args, ct);
+  _Str8__vcat(arena, dst, ct, args);
+  va_end(args);
+}
+
 // slices inherit the lifetime and mutability of an existing buf
 void Str8__sliceOf(Str8* dst, Str8* src) {
   dst->slice = true;
@@ -232,18 +246,23 @@ void Str8__dirname(Str8* dst, Str8* s) {
   STR8_INHERIT_NULL(dst, s, end);
 }
 
-char* Str8__cstr(Str8* s) {
+// null-terminated view; copies into arena only when s isn't already terminated
+char* Str8__cstrTo(Arena* arena, Str8* s) {
   Str8__init(s);
   if (!s->slice && 0 == s->str[s->len]) {
     return s->str;
   }
   // copy
-  char* r = Arena__push(_G->arena, s->len + 1);
+  char* r = Arena__push(arena, s->len + 1);
   memcpy(r, s->str, s->len);
   r[s->len] = 0;  // null-terminate
   return r;
 }
 
+char* Str8__cstr(Str8* s) {
+  return Str8__cstrTo(ThreadCtx__get()->arena, s);
+}
+
 // TODO: Str8__split(&parts, file, &(Str8){"/"}, 0);
 
 // Perform sprintf-style pattern matching against a given string.
@@ -375,6 +394,70 @@ u64 Str8__scan(Str8* input, const char* format, ...) {
   return p_input - input->str;  // matched chars
 }
 
+// ---
+// Str8 interning
+
+// usage:
+//   static StrId K_NAME;
+//   K_NAME = Str8__intern(&(Str8){.str = "name"});  // at startup
+//   StrId key;
+//   while (Json__object_key_id(json, &key)) {
+//     if (K_NAME == key) { ... }  // integer compare; no strcmp per key
+//   }
+
+// NOTE: not thread-safe; intern at startup (or from one thread), then Str8__find() from any
+
+#define _STR8__HASH(s) Hash__bytes((s).str, (s).len)
+#define _STR8__EQ(a, b) ((a).len == (b).len && 0 == memcmp((a).str, (b).str, (a).len))
+
+GENERIC_HASHMAP_FNS(Str8Map, Str8, StrId, _STR8__HASH, _STR8__EQ)
+GENERIC_VEC_FNS(Str8Vec, Str8)
+
+// Id for text, interning a copy into _G->arena (STR_ARENA1) the first time it's seen
+// @returns STR8__ID_NONE if the arena is full
+StrId Str8__intern(Str8* s) {
+  Str8Table* t = &_G->strings;
+  Str8__init(s);
+  if (NULL == t->strs.data) {
+    if (!Str8Map__init(&t->ids, _G->arena, 256) || !Str8Vec__init(&t->strs, _G->arena, 256) ||
+        NULL == Str8Vec__push(&t->strs, (Str8){0})) {
+      return STR8__ID_NONE;
+    }
+  }
+  StrId* found = Str8Map__get(&t->ids, *s);
+  if (NULL != found) {
+    return *found;
+  }
+  char* copy = (char*)Arena__push(_G->arena, s->len + 1);
+  if (NULL == copy) {
+    return STR8__ID_NONE;
+  }
+  memcpy(copy, s->str, s->len);
+  copy[s->len] = 0;  // null-terminate (for convenience)
+  Str8 str = {.str = copy, .len = s->len, .slice = false, .mut = false, .life = STR_ARENA1};
+  StrId id = t->strs.len;
+  if (NULL == Str8Vec__push(&t->strs, str) || NULL == Str8Map__put(&t->ids, str, id)) {
+    return STR8__ID_NONE;
+  }
+  return id;
+}
+
+// Id for text if it was interned, else STR8__ID_NONE (never allocates)
+StrId Str8__find(Str8* s) {
+  Str8__init(s);
+  if (NULL == _G->strings.strs.data) {
+    return STR8__ID_NONE;
+  }
+  StrId* found = Str8Map__get(&_G->strings.ids, *s);
+  return NULL != found ? *found : STR8__ID_NONE;
+}
+
+// Interned text for id (shared; immutable, null-terminated)
+Str8 Str8__interned(StrId id) {
+  Str8* s = Str8Vec__get(&_G->strings.strs, id);
+  return NULL != s ? *s : (Str8){.str = "", .life = STR_STATIC};
+}
+
 // ---
 // cstr utils
 
@@ -388,7 +471,7 @@ u32 cstr__len(const char* c) {
 // ideal for references to static strings that get hot-reloaded
 const char* cstr_arena1(const char* cstr) {
   u32 len = Str8__cstrlen(cstr);
-  const char* r = Arena__push(_G->arena, len + 1);
+  const char* r = Arena__push(ThreadCtx__get()->arena, len + 1);
   memcpy((char*)r, cstr, len);
   return r;
 }
@@ -410,11 +493,14 @@ static inline bool cstr__eq(u32 len, const char* a, const char* b) {
 }
 
 char* cstr__vformat(Arena* arena, u32 maxlen, const char* fmt, va_list args) {
-  char buf[maxlen];
-  u32 l = vsnprintf(buf, maxlen, fmt, args) + 1;
-  char* s = Arena__push(arena, l);
-  memcpy(s, buf, l);
-  s[l] = 0;  // null-terminate
+  // format straight into the arena, then give back the unused tail
+  ArenaTemp t = ArenaTemp__begin(arena);
+  char* s = Arena__push(arena, maxlen);
+  s32 l = vsnprintf(s, maxlen, fmt, args);
+  ArenaTemp__end(t);
+  u32 len = l < 0 ? 0 : Math__min((u32)l, maxlen - 1);  // truncated to fit
+  Arena__push(arena, len + 1);  // same address as s
+  s[len] = 0;  // null-terminate
   return s;
 }
 
@@ -493,6 +579,6 @@ char* _format_bytes(char* buf, u64 bytes, bool round) {
 
 // human-readable bytes (e.g., 1024 -> "1 KB")
 char* format_bytes(u64 bytes, bool round) {
-  char* buf = Arena__push(_G->frameArena, 16);
+  char* buf = Arena__push(ThreadCtx__get()->frameArena, 16);
   return _format_bytes(buf, bytes, round);
 }
\ No newline at end of file
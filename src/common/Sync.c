@@ -0,0 +1,252 @@
+#pragma once
+
+#include "../unity.h"  // IWYU pragma: keep
+
+// inspired by:
+// - [2011 Ulrich Drepper - Futexes Are Tricky](https://www.akkadia.org/drepper/futex.pdf)
+// - [1991 Mellor-Crummey & Scott - Algorithms for Scalable Synchronization](https://www.cs.rochester.edu/u/scott/papers/1991_TOCS_synch.pdf)
+
+// @class Futex
+// Function | Purpose
+// --- | ---
+// Futex__wait(addr, expected, ms) | Sleep while *addr == expected (ms = 0 waits forever)
+// Futex__wake(addr, ct) | Wake up to ct threads sleeping on addr
+
+// @class SyncMutex
+// Function | Purpose
+// --- | ---
+// SyncMutex__tryLock(m) | Acquire if free, without waiting
+// SyncMutex__lock(m) | Acquire; spin, then sleep
+// SyncMutex__unlock(m) | Release; wake one sleeper if any
+
+// @class TicketLock
+// Function | Purpose
+// --- | ---
+// TicketLock__lock(l) | Acquire in arrival order (never sleeps)
+// TicketLock__unlock(l) | Admit the next ticket
+
+// @class RWLock
+// Function | Purpose
+// --- | ---
+// RWLock__readLock(l) | Acquire shared (waits while a writer holds or wants it)
+// RWLock__readUnlock(l) | Release shared
+// RWLock__writeLock(l) | Acquire exclusive
+// RWLock__writeUnlock(l) | Release exclusive
+
+// @class Event
+// Function | Purpose
+// --- | ---
+// Event__set(e) | Signal; releases one waiter (or the next to wait)
+// Event__wait(e, ms) | Wait for signal and consume it (ms = 0 waits forever)
+
+#define RWLOCK__WRITER (0x80000000u)
+#define RWLOCK__WRITER_WAIT (0x40000000u)
+#define RWLOCK__READERS (0x3fffffffu)
+
+#ifdef __linux__
+// from <linux/futex.h> (not shipped with musl)
+#define FUTEX__WAIT_PRIVATE (128 | 0)
+#define FUTEX__WAKE_PRIVATE (128 | 1)
+#endif
+
+// ---
+// Futex
+
+// Sleep while *addr == expected (ms = 0 waits forever)
+// may return early (spuriously); callers must re-check their condition
+void Futex__wait(u32* addr, u32 expected, u32 ms) {
+#ifdef _WIN32
+  WaitOnAddress(addr, &expected, sizeof(u32), 0 == ms ? INFINITE : ms);
+#elif __linux__
+  struct timespec ts = {.tv_sec = ms / 1000, .tv_nsec = (ms % 1000) * 1000000};
+  syscall(SYS_futex, addr, FUTEX__WAIT_PRIVATE, expected, 0 == ms ? NULL : &ts, NULL, 0);
+#elif __EMSCRIPTEN__
+  Thread__yield();
+#endif
+}
+
+// Wake up to ct threads sleeping on addr
+void Futex__wake(u32* addr, u32 ct) {
+#ifdef _WIN32
+  if (1 == ct) {
+    WakeByAddressSingle(addr);
+  } else {
+    WakeByAddressAll(addr);
+  }
+#elif __linux__
+  syscall(SYS_futex, addr, FUTEX__WAKE_PRIVATE, Math__min(ct, INT32_MAX), NULL, NULL, 0);
+#elif __EMSCRIPTEN__
+  return;
+#endif
+}
+
+// ---
+// SyncMutex
+
+// Acquire if free, without waiting
+bool SyncMutex__tryLock(SyncMutex* m) {
+  u32 c = 0;
+  return Atomic__cas(&m->state, &c, 1);
+}
+
+// Acquire; spin, then sleep
+void SyncMutex__lock(SyncMutex* m) {
+  u32 c = 0;
+  for (u32 i = 0; i < SYNC__SPIN_CT; i++) {
+    c = 0;
+    if (Atomic__cas(&m->state, &c, 1)) {
+      return;
+    }
+    if (2 == c) {
+      break;  // others already asleep; queue up behind them
+    }
+    Atomic__pause();
+  }
+  // mark contended so unlock() knows to wake; sleep until we swap in from 0
+  c = Atomic__xchg(&m->state, 2);
+  while (0 != c) {
+    Futex__wait(&m->state, 2, 0);
+    c = Atomic__xchg(&m->state, 2);
+  }
+}
+
+// Release; wake one sleeper if any
+void SyncMutex__unlock(SyncMutex* m) {
+  if (2 == Atomic__xchg(&m->state, 0)) {
+    Futex__wake(&m->state, 1);
+  }
+}
+
+// ---
+// TicketLock
+
+// Acquire in arrival order (never sleeps)
+void TicketLock__lock(TicketLock* l) {
+  u32 ticket = Atomic__add(&l->next, 1);
+  for (u32 spin = 0; ticket != Atomic__load(&l->serving); spin++) {
+    if (spin < SYNC__SPIN_CT) {
+      Atomic__pause();
+    } else {
+      Thread__yield();  // holder or earlier ticket was preempted
+    }
+  }
+}
+
+// Admit the next ticket
+void TicketLock__unlock(TicketLock* l) {
+  Atomic__store(&l->serving, Atomic__loadRelaxed(&l->serving) + 1);
+}
+
+// ---
+// RWLock
+
+// sleep on l->state while it still reads `seen`
+static void _RWLock__sleep(RWLock* l, u32 seen) {
+  Atomic__add(&l->waiters, 1);
+  Atomic__fence();  // pairs with fence in _RWLock__wakeAll()
+  Futex__wait(&l->state, seen, 0);
+  Atomic__sub(&l->waiters, 1);
+}
+
+static void _RWLock__wakeAll(RWLock* l) {
+  Atomic__fence();  // state change visible before reading waiters
+  if (0 != Atomic__load(&l->waiters)) {
+    Futex__wake(&l->state, UINT32_MAX);
+  }
+}
+
+// Acquire shared (waits while a writer holds or wants it)
+void RWLock__readLock(RWLock* l) {
+  u32 s = Atomic__loadRelaxed(&l->state);
+  for (u32 spin = 0;; spin++) {
+    if (!(s & (RWLOCK__WRITER | RWLOCK__WRITER_WAIT))) {
+      if (Atomic__cas(&l->state, &s, s + 1)) {
+        return;
+      }
+      continue;  // s reloaded by CAS
+    }
+    if (spin < SYNC__SPIN_CT) {
+      Atomic__pause();
+    } else {
+      _RWLock__sleep(l, s);
+    }
+    s = Atomic__loadRelaxed(&l->state);
+  }
+}
+
+// Release shared
+void RWLock__readUnlock(RWLock* l) {
+  u32 s = Atomic__sub(&l->state, 1) - 1;
+  if (0 == (s & RWLOCK__READERS) && (s & RWLOCK__WRITER_WAIT)) {
+    _RWLock__wakeAll(l);  // last reader out; let the writer in
+  }
+}
+
+// Acquire exclusive
+void RWLock__writeLock(RWLock* l) {
+  u32 s = Atomic__loadRelaxed(&l->state);
+  for (u32 spin = 0;; spin++) {
+    if (!(s & (RWLOCK__READERS | RWLOCK__WRITER))) {
+      // clears WRITER_WAIT; other waiting writers set it again when they retry
+      if (Atomic__cas(&l->state, &s, RWLOCK__WRITER)) {
+        return;
+      }
+      continue;
+    }
+    if (!(s & RWLOCK__WRITER_WAIT)) {
+      // hold off new readers so they can't starve us
+      if (!Atomic__cas(&l->state, &s, s | RWLOCK__WRITER_WAIT)) {
+        continue;
+      }
+      s |= RWLOCK__WRITER_WAIT;
+    }
+    if (spin < SYNC__SPIN_CT) {
+      Atomic__pause();
+    } else {
+      _RWLock__sleep(l, s);
+    }
+    s = Atomic__loadRelaxed(&l->state);
+  }
+}
+
+// Release exclusive
+void RWLock__writeUnlock(RWLock* l) {
+  Atomic__store(&l->state, 0);
+  _RWLock__wakeAll(l);  // readers and writers all retry; a waiting writer re-raises WRITER_WAIT
+}
+
+// ---
+// Event
+
+// Signal; releases one waiter (or the next to wait)
+void Event__set(Event* e) {
+  if (0 == Atomic__xchg(&e->signaled, 1)) {
+    Atomic__fence();  // pairs with fence in Event__wait()
+    if (0 != Atomic__load(&e->waiters)) {
+      Futex__wake(&e->signaled, 1);
+    }
+  }
+}
+
+// Wait for signal and consume it (ms = 0 waits forever)
+// @returns false on timeout
+bool Event__wait(Event* e, u32 ms) {
+  u64 deadline = Time__now() + ms;
+  for (;;) {
+    if (1 == Atomic__xchg(&e->signaled, 0)) {
+      return true;
+    }
+    u32 left = 0;
+    if (0 != ms) {
+      u64 now = Time__now();
+      if (now >= deadline) {
+        return false;
+      }
+      left = (u32)(deadline - now);
+    }
+    Atomic__add(&e->waiters, 1);
+    Atomic__fence();  // waiters visible before re-checking signaled
+    Futex__wait(&e->signaled, 0, left);
+    Atomic__sub(&e->waiters, 1);
+  }
+}
\ No newline at end of file
@@ -16,8 +16,54 @@
 // Function | Purpose
 // --- | ---
 // Thread__create(t, fn, userdata) | Create and start a new thread
+// Thread__createAttr(t, fn, userdata, attr) | Create thread with pinning, priority, NUMA, prefault
+// Thread__applyAttr(attr) | Apply pinning, priority, NUMA policy to calling thread
+// Thread__lockMemory() | Lock all current + future pages in RAM (no page faults; Linux only)
 // Thread__join(t[], len) | Wait for threads to complete
 // Thread__destroy(t[], len) | Clean up thread resources
+// Thread__yield() | Give up the rest of this time slice
+
+// @class ThreadCtx
+// Function | Purpose
+// --- | ---
+// ThreadCtx__get() | Calling thread's context (per-thread arenas)
+
+// @class Scratch
+// Function | Purpose
+// --- | ---
+// Scratch__begin(conflict) | Temp region on a thread scratch arena other than conflict
+// Scratch__end(t) | Release everything pushed since Scratch__begin()
+
+// usage:
+//   ThreadAttr attr = THREAD_ATTR_DEFAULT;
+//   attr.core = 2;  // keep the net thread off the tick thread's core
+//   attr.priority = 50;  // needs CAP_SYS_NICE (or rtprio in limits.conf)
+//   attr.prefault = true;
+//   Thread__createAttr(&t, Net__main, NULL, &attr);
+//
+//   // temporaries that must not outlive this function
+//   char* Path__join(Arena* out, const char* dir, const char* file) {
+//     ArenaTemp scratch = Scratch__begin(out);  // never the arena we return into
+//     char* tmp = cstr__format(scratch.arena, 256, "%s/%s", dir, file);
+//     char* r = cstr_arena1(Path__normalize(tmp));
+//     Scratch__end(scratch);
+//     return r;
+//   }
+
+static __thread ThreadCtx* _Thread__ctx = NULL;  // NULL until Thread__create() (or on main)
+static ThreadCtx _Thread__mainCtx;
+static u32 _Thread__nextId = 1;
+
+// heap-allocated hand-off from Thread__create() to the new thread
+typedef struct {
+  thread_fn_t fn;
+  void* userdata;
+  ThreadAttr attr;
+} ThreadStart;
+
+#ifdef __linux__
+#define MPOL__PREFERRED (1)  // from <linux/mempolicy.h> (not shipped with musl)
+#endif
 
 // Create a new mutex
 bool Thread__Mutex_create(Mutex* m) {
@@ -25,7 +71,7 @@ bool Thread__Mutex_create(Mutex* m) {
   m->_win = CreateMutex(NULL, FALSE, NULL);
   return m->_win != NULL;
 #elif __linux__
-  return 0 != pthread_mutex_init(&m->_nix, NULL);
+  return 0 == pthread_mutex_init(&m->_nix, NULL);
 #elif __EMSCRIPTEN__
   return false;
 #endif
@@ -64,19 +110,176 @@ void Thread__Mutex_destroy(Mutex* m) {
 #endif
 }
 
-// Create and start a new thread
-bool Thread__create(Thread* t, thread_fn_t fn, void* userdata) {
+// Calling thread's context (per-thread arenas)
+ThreadCtx* ThreadCtx__get(void) {
+  if (NULL != _Thread__ctx) {
+    return _Thread__ctx;
+  }
+  // main thread (or any thread not started by Thread__create) shares _G's arenas
+  _Thread__mainCtx.arena = _G->arena;
+  _Thread__mainCtx.frameArena = _G->frameArena;
+  if (NULL == _Thread__mainCtx.scratch[0]) {
+    _Thread__mainCtx.scratch[0] = Arena__reserve(THREAD__SCRATCH_SZ, THREAD__SCRATCH_KEEP);
+    _Thread__mainCtx.scratch[1] = Arena__reserve(THREAD__SCRATCH_SZ, THREAD__SCRATCH_KEEP);
+  }
+  return &_Thread__mainCtx;
+}
+
+// Temp region on a thread scratch arena other than conflict
+// conflict = the arena the caller allocates its result into (or NULL);
+// with two scratch arenas, a callee never rolls back its caller's scratch data
+ArenaTemp Scratch__begin(Arena* conflict) {
+  ThreadCtx* ctx = ThreadCtx__get();
+  Arena* a = conflict == ctx->scratch[0] ? ctx->scratch[1] : ctx->scratch[0];
+  return ArenaTemp__begin(a);
+}
+
+// Release everything pushed since Scratch__begin()
+void Scratch__end(ArenaTemp t) {
+  ArenaTemp__end(t);
+}
+
+// Apply pinning, priority, NUMA policy to calling thread
+// failures are not fatal (ie. no CAP_SYS_NICE); the thread keeps OS defaults
+// @returns THREAD__* flags that were granted
+u32 Thread__applyAttr(const ThreadAttr* attr) {
+  u32 flags = 0;
+#ifdef _WIN32
+  if (attr->core >= 0 && SetThreadAffinityMask(GetCurrentThread(), (u64)1 << attr->core)) {
+    flags |= THREAD__PINNED;
+  }
+  if (attr->priority > 0 && SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_TIME_CRITICAL)) {
+    flags |= THREAD__REALTIME;
+  }
+  if (attr->numaNode >= 0) {
+    // Windows serves a thread's new pages from the node of the processor it runs on,
+    // so keeping the thread on numaNode's processors keeps its memory there
+    GROUP_AFFINITY node = {0};
+    if (GetNumaNodeProcessorMaskEx((USHORT)attr->numaNode, &node)) {
+      if (flags & THREAD__PINNED) {
+        PROCESSOR_NUMBER pn = {.Group = 0, .Number = (BYTE)attr->core};
+        USHORT pinnedNode = 0;
+        if (GetNumaProcessorNodeEx(&pn, &pinnedNode) && pinnedNode == attr->numaNode) {
+          flags |= THREAD__NUMA_LOCAL;  // pinned core already lives on numaNode
+        }
+      } else if (SetThreadGroupAffinity(GetCurrentThread(), &node, NULL)) {
+        flags |= THREAD__NUMA_LOCAL;
+      }
+    }
+  }
+#elif __linux__
+  if (attr->core >= 0 && attr->core < CPU_SETSIZE) {
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(attr->core, &set);
+    if (0 == pthread_setaffinity_np(pthread_self(), sizeof(set), &set)) {
+      flags |= THREAD__PINNED;
+    }
+  }
+  if (attr->priority > 0) {
+    struct sched_param sp = {.sched_priority = attr->priority};
+    if (0 == pthread_setschedparam(pthread_self(), SCHED_FIFO, &sp)) {
+      flags |= THREAD__REALTIME;
+    }
+  }
+  if (attr->numaNode >= 0 && attr->numaNode < 64) {
+    // new pages for this thread come from numaNode (falls back to others when full)
+    u64 mask = (u64)1 << attr->numaNode;
+    if (0 == syscall(SYS_set_mempolicy, MPOL__PREFERRED, &mask, sizeof(mask) * 8 + 1)) {
+      flags |= THREAD__NUMA_LOCAL;
+    }
+  }
+#endif
+  return flags;
+}
+
+// Lock all current + future pages in RAM (no page faults)
+// needs CAP_IPC_LOCK (or a large enough RLIMIT_MEMLOCK)
+// Linux only: Windows has no lock for future pages (VirtualLock is per range, capped by the
+// working set), so there it returns false and the process keeps OS paging
+bool Thread__lockMemory(void) {
 #ifdef _WIN32
-  t->_win = CreateThread(NULL, 0, fn, userdata, 0, NULL);
-  return NULL != t->_win;
+  return false;
 #elif __linux__
-  return 0 == pthread_create(&t->_nix, NULL, fn, userdata);
+  return 0 == mlockall(MCL_CURRENT | MCL_FUTURE);
 #elif __EMSCRIPTEN__
-  // TODO: implement WebWorkers as threads?
   return false;
 #endif
 }
 
+// touch the top of this thread's stack so the hot path doesn't grow it by faulting
+static void _Thread__prefaultStack(void) {
+  volatile u8 stack[THREAD__PREFAULT_STACK_SZ];
+  for (u32 i = 0; i < sizeof(stack); i += ARENA__PAGE_SZ) {
+    stack[i] = 0;
+  }
+}
+
+// entry point of every Thread__create() thread; owns the thread's arenas
+static THREAD_FN_RET _Thread__main(THREAD_FN_PARAM1 param) {
+  ThreadStart start = *(ThreadStart*)param;
+  free(param);
+
+  // pin + set memory policy before allocating, so arena pages land on the right node
+  ThreadCtx ctx = {.flags = Thread__applyAttr(&start.attr)};
+  ctx.arena = Arena__alloc(THREAD__ARENA_SZ);
+  ctx.frameArena = Arena__alloc(THREAD__FRAME_ARENA_SZ);
+  ctx.scratch[0] = Arena__reserve(THREAD__SCRATCH_SZ, THREAD__SCRATCH_KEEP);
+  ctx.scratch[1] = Arena__reserve(THREAD__SCRATCH_SZ, THREAD__SCRATCH_KEEP);
+  ctx.id = Atomic__add(&_Thread__nextId, 1);
+  ASSERT_CONTEXT(
+      ctx.arena && ctx.frameArena && ctx.scratch[0] && ctx.scratch[1],
+      "Failed to allocate thread %u arenas",
+      ctx.id);
+  if (start.attr.prefault) {
+    Arena__prefault(ctx.arena);
+    Arena__prefault(ctx.frameArena);
+    _Thread__prefaultStack();
+    ctx.flags |= THREAD__PREFAULTED;
+  }
+  _Thread__ctx = &ctx;
+
+  start.fn(start.userdata);
+
+  _Thread__ctx = NULL;
+  Arena__free(ctx.arena);
+  Arena__free(ctx.frameArena);
+  Arena__free(ctx.scratch[0]);
+  Arena__free(ctx.scratch[1]);
+  return THREAD_FN_RET_VAL;
+}
+
+// Create thread with core pinning, priority, NUMA, prefault (attr NULL = OS defaults)
+// attributes the OS refuses are skipped; check ThreadCtx__get()->flags from inside the thread
+bool Thread__createAttr(Thread* t, thread_fn_t fn, void* userdata, const ThreadAttr* attr) {
+  ThreadStart* start = (ThreadStart*)malloc(sizeof(ThreadStart));
+  if (NULL == start) {
+    return false;
+  }
+  start->fn = fn;
+  start->userdata = userdata;
+  start->attr = NULL != attr ? *attr : THREAD_ATTR_DEFAULT;
+#ifdef _WIN32
+  t->_win = CreateThread(NULL, 0, _Thread__main, start, 0, NULL);
+  if (NULL != t->_win) {
+    return true;
+  }
+#elif __linux__
+  if (0 == pthread_create(&t->_nix, NULL, _Thread__main, start)) {
+    return true;
+  }
+#elif __EMSCRIPTEN__
+  // TODO: implement WebWorkers as threads?
+#endif
+  free(start);
+  return false;
+}
+
+// Create and start a new thread
+bool Thread__create(Thread* t, thread_fn_t fn, void* userdata) {
+  return Thread__createAttr(t, fn, userdata, NULL);
+}
+
 // Wait for threads to complete
 void Thread__join(Thread t[], u32 len) {
 #ifdef _WIN32
@@ -101,4 +304,15 @@ void Thread__destroy(Thread t[], u32 len) {
 #elif __EMSCRIPTEN__
   return;
 #endif
+}
+
+// Give up the rest of this time slice (ie. while spin-waiting on another thread)
+void Thread__yield(void) {
+#ifdef _WIN32
+  SwitchToThread();
+#elif __linux__
+  sched_yield();
+#elif __EMSCRIPTEN__
+  return;
+#endif
 }
\ No newline at end of file
@@ -0,0 +1,142 @@
+#pragma once
+
+#include "../unity.h"  // IWYU pragma: keep
+
+// @class Vec (generated by GENERIC_VEC_FNS)
+// Function | Purpose
+// --- | ---
+// N__init(v, arena, cap) | Empty vec with room for cap items
+// N__reserve(v, cap) | Grow capacity to at least cap
+// N__push(v, x) | Append; returns pointer to the stored item (NULL if arena full)
+// N__pop(v, out) | Remove last item into out; false if empty
+// N__get(v, i) | Pointer to item i, or NULL if out of range
+// N__insert(v, i, x) | Insert at i, shifting later items up
+// N__remove(v, i) | Remove item i, keeping order (O(n))
+// N__swapRemove(v, i) | Remove item i by moving the last item into it (O(1))
+// N__sort(v, cmp) | Sort in place; cmp(const T*, const T*) like qsort()
+// N__clear(v) | Remove all items (keeps capacity)
+// N##It__each(it) | Iterator, same loop shape as ListIt__each()
+
+// usage:
+//   GENERIC_VEC(Bodies, Body);  // types Bodies + BodiesIt (see unity.h)
+//   GENERIC_VEC_FNS(Bodies, Body);  // functions
+//   Bodies__init(&sim->bodies, _G->arena, 256);
+//   Bodies__push(&sim->bodies, (Body){.mass = 1});
+//
+//   BodiesIt it = {&sim->bodies};
+//   while (BodiesIt__each(&it)) { Body__step(it.item); }
+
+// NOTE: growing moves the items unless data sits on top of the arena, so pointers from
+// push()/get() are only good until the next push/insert/reserve
+
+#define VEC__MIN_CAP (8)
+
+#define GENERIC_VEC_FNS(N, T)                                                  \
+  /* Empty vec with room for cap items */                                      \
+  static inline bool N##__init(N* v, Arena* arena, u32 cap) {                  \
+    v->arena = arena;                                                          \
+    v->len = 0;                                                                \
+    v->cap = cap;                                                              \
+    v->data = 0 != cap ? Arena__pushArray(arena, T, cap) : NULL;               \
+    return 0 == cap || NULL != v->data;                                        \
+  }                                                                            \
+                                                                               \
+  /* Grow capacity to at least cap */                                          \
+  static inline bool N##__reserve(N* v, u32 cap) {                             \
+    if (cap <= v->cap) {                                                       \
+      return true;                                                             \
+    }                                                                          \
+    u8* top = (u8*)(v->data + v->cap);                                         \
+    if (NULL != v->data && top == v->arena->pos) {                             \
+      /* nothing pushed since; just extend */                                  \
+      if (NULL == Arena__push(v->arena, (u64)(cap - v->cap) * sizeof(T))) {    \
+        return false;                                                          \
+      }                                                                        \
+    } else {                                                                   \
+      T* data = Arena__pushArray(v->arena, T, cap);                            \
+      if (NULL == data) {                                                      \
+        return false;                                                          \
+      }                                                                        \
+      if (0 != v->len) {                                                       \
+        memcpy(data, v->data, (u64)v->len * sizeof(T));                        \
+      }                                                                        \
+      v->data = data; /* old block is left to the arena reset */               \
+    }                                                                          \
+    v->cap = cap;                                                              \
+    return true;                                                               \
+  }                                                                            \
+                                                                               \
+  /* Append; returns pointer to the stored item (NULL if arena full) */        \
+  static inline T* N##__push(N* v, T x) {                                      \
+    if (v->len == v->cap &&                                                    \
+        !N##__reserve(v, v->cap < VEC__MIN_CAP ? VEC__MIN_CAP : v->cap * 2)) { \
+      return NULL;                                                             \
+    }                                                                          \
+    v->data[v->len] = x;                                                       \
+    return &v->data[v->len++];                                                 \
+  }                                                                            \
+                                                                               \
+  /* Remove last item into out; false if empty */                              \
+  static inline bool N##__pop(N* v, T* out) {                                  \
+    if (0 == v->len) {                                                         \
+      return false;                                                            \
+    }                                                                          \
+    *out = v->data[--v->len];                                                  \
+    return true;                                                               \
+  }                                                                            \
+                                                                               \
+  /* Pointer to item i, or NULL if out of range */                             \
+  static inline T* N##__get(N* v, u32 i) {                                     \
+    return i < v->len ? &v->data[i] : NULL;                                    \
+  }                                                                            \
+                                                                               \
+  /* Insert at i, shifting later items up */                                   \
+  static inline T* N##__insert(N* v, u32 i, T x) {                             \
+    if (i > v->len || NULL == N##__push(v, x)) {                               \
+      return NULL;                                                             \
+    }                                                                          \
+    memmove(&v->data[i + 1], &v->data[i], (u64)(v->len - 1 - i) * sizeof(T));  \
+    v->data[i] = x;                                                            \
+    return &v->data[i];                                                        \
+  }                                                                            \
+                                                                               \
+  /* Remove item i, keeping order (O(n)) */                                    \
+  static inline bool N##__remove(N* v, u32 i) {                                \
+    if (i >= v->len) {                                                         \
+      return false;                                                            \
+    }                                                                          \
+    memmove(&v->data[i], &v->data[i + 1], (u64)(v->len - 1 - i) * sizeof(T));  \
+    v->len--;                                                                  \
+    return true;                                                               \
+  }                                                                            \
+                                                                               \
+  /* Remove item i by moving the last item into it (O(1)) */                   \
+  static inline bool N##__swapRemove(N* v, u32 i) {                            \
+    if (i >= v->len) {                                                         \
+      return false;                                                            \
+    }                                                                          \
+    v->data[i] = v->data[--v->len];                                            \
+    return true;                                                               \
+  }                                                                            \
+                                                                               \
+  /* Sort in place; cmp(const T*, const T*) like qsort() */                    \
+  static inline void N##__sort(N* v, int (*cmp)(const void*, const void*)) {   \
+    if (v->len > 1) {                                                          \
+      qsort(v->data, v->len, sizeof(T), cmp);                                  \
+    }                                                                          \
+  }                                                                            \
+                                                                               \
+  /* Remove all items (keeps capacity) */                                      \
+  static inline void N##__clear(N* v) {                                        \
+    v->len = 0;                                                                \
+  }                                                                            \
+                                                                               \
+  /* Iterator, same loop shape as ListIt__each() */                            \
+  static inline bool N##It__each(N##It* it) {                                  \
+    it->i = NULL == it->item ? 0 : it->i + 1;                                  \
+    if (it->i >= it->vec->len) {                                               \
+      return false;                                                            \
+    }                                                                          \
+    it->item = &it->vec->data[it->i];                                          \
+    return true;                                                               \
+  }
@@ -1,7 +1,14 @@
 #include "unity.h"
 
+#define MAIN__ARENA_RESERVE (1024ULL * 1024 * 1024)  // 1 GB address space
+#define MAIN__FRAME_ARENA_RESERVE (256ULL * 1024 * 1024)
+#define MAIN__FRAME_ARENA_KEEP (4ULL * 1024 * 1024)  // stays committed across frame resets
+#define MAIN__MAX_ENTITIES (64 * 1024)
+
 static void _Main__onSignal(int sig) {
   printf("Caught signal %d, shutting down gracefully...\n", sig);
+  ARENA__PRINT(_G->arena, "arena");
+  ARENA__PRINT(_G->frameArena, "frameArena");
   exit(0);
 }
 
@@ -9,10 +16,19 @@ int main(int argc, char* argv[]) {
   signal(SIGINT, _Main__onSignal);
   Console__init();
 
-  _G->arena = Arena__allocZ(1024);
+  // reserve generously; only pages actually pushed into cost physical memory
+  _G->arena = Arena__reserve(MAIN__ARENA_RESERVE, ARENA__KEEP_ALL);
   ASSERT_CONTEXT(_G->arena, "Failed to allocate arena");
-  _G->frameArena = Arena__allocZ(1024);
+  _G->frameArena = Arena__reserve(MAIN__FRAME_ARENA_RESERVE, MAIN__FRAME_ARENA_KEEP);
   ASSERT_CONTEXT(_G->frameArena, "Failed to allocate frame arena");
+  if (!Parallel__init(0)) {  // one worker per extra core
+    fprintf(stderr, "Failed to start worker pool\n");
+    return 1;
+  }
+  if (!Ecs__init(&_G->ecs, _G->arena, MAIN__MAX_ENTITIES)) {
+    fprintf(stderr, "Failed to allocate entity store\n");
+    return 1;
+  }
 
   printf("Starting application...\n");
   while (true) {
@@ -20,6 +36,7 @@ int main(int argc, char* argv[]) {
     printf("  ts: %ld pnow: %ld now: %ld\n", Time__unix_ts(), Time__perf_now(), Time__now());
     // fflush(stdout);
     Time__sleep_ms(1000);
+    Arena__reset(_G->frameArena);  // end of tick
   }
   return 0;
 }
\ No newline at end of file
@@ -5,6 +5,7 @@
 // Global Dependencies
 
 #define _XOPEN_SOURCE 500  // enable POSIX features in standard headers
+#define _GNU_SOURCE  // enable Linux extensions (syscall(), futex, CPU affinity)
 // #define _CRT_SECURE_NO_WARNINGS  // ignore warnings about fopen()
 #include <signal.h>  // IWYU pragma: keep // signal()
 #include <stdarg.h>  // IWYU pragma: keep // va_list
@@ -101,14 +102,119 @@ static const char* S_CONSOLE_LOG3 = "Assertion failed: %s\n  at %s:%u\n";
 
 // Arena
 
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN  // keep winsock.h out; Socket includes winsock2.h
+#include <windows.h>  // VirtualAlloc()
+#elif __linux__
+#include <sys/mman.h>  // mmap(), mprotect(), madvise()
+#endif
+
+#define ARENA__PAGE_SZ (4096)  // smallest OS page; stride for touching every page
+#define ARENA__COMMIT_SZ (64 * 1024)  // VM arenas commit in steps of this
+#define ARENA__KEEP_ALL (UINT64_MAX)  // Arena.keep: never decommit on reset
+
+#define ARENA__HUGE_PAGE_SZ (2 * 1024 * 1024)  // x86-64 / ARM64 huge page
+#define ARENA__DONTNEED_MIN (256 * 1024)  // below this, memset beats madvise + refault
+
+#define CACHELINE_SZ (64)  // bytes; x86-64 and most ARM64 cores
+#define CACHELINE(sz) (((sz) + CACHELINE_SZ - 1) & ~(u64)(CACHELINE_SZ - 1))  // whole lines
+
+// Arena.flags; requests for Arena__allocFlags() + state
+#define ARENA__VM (1 << 0)  // reserved address range, committed on demand
+#define ARENA__MAPPED (1 << 1)  // fixed-size OS mapping (Arena__allocFlags)
+#define ARENA__HUGE (1 << 2)  // request 2MB pages (hugetlb, else THP)
+#define ARENA__POPULATE (1 << 3)  // request all pages faulted in up front
+#define ARENA__POPULATED (1 << 4)  // result: pages were faulted in up front
+
+// per-call-site push accounting, peak + reset history (Arena__printf); debug builds only
+#ifdef DEBUG_SLOW
+#define ARENA__INSTRUMENTED
+#endif
+#define ARENA__MAX_SITES (256)  // distinct push call sites tracked per arena (power of 2)
+#define ARENA__HISTORY_CT (120)  // bytes-in-use samples kept, one per Arena__reset() (~2s at 60Hz)
+#ifdef ARENA__INSTRUMENTED
+#define ARENA__PRINT(a, name) Arena__printf(a, name)
+#else
+#define ARENA__PRINT(a, name)
+#endif
+
+// physical backing actually obtained (see Arena__backing())
+typedef enum {
+  ARENA_HEAP,  // malloc
+  ARENA_PAGES,  // OS mapping, base (4KB) pages
+  ARENA_HUGETLB,  // reserved huge pages (MAP_HUGETLB / MEM_LARGE_PAGES)
+  ARENA_THP,  // base mapping, 2MB aligned + MADV_HUGEPAGE (kernel promotes when it can)
+} ArenaBacking;
+
+typedef struct {
+  const char* file;  // NULL = empty slot
+  u32 line;
+  u32 pushes;
+  u64 bytes;
+} ArenaSite;
+
+typedef struct {
+  u64 peak;  // most bytes ever in use at once
+  u64 pushes;
+  u64 dropped;  // bytes from call sites past ARENA__MAX_SITES
+  u32 siteCt;
+  u32 resets;  // total; next sample goes to history[resets % ARENA__HISTORY_CT]
+  ArenaSite sites[ARENA__MAX_SITES];  // open addressing on (file, line)
+  u64 history[ARENA__HISTORY_CT];  // bytes in use at each reset (per tick, for frame arenas)
+} ArenaStats;
+
 typedef struct {
   u8* buf;
   u8* pos;
-  u8* end;
+  u8* end;  // end of reserved range
+  u8* commit;  // end of committed (usable) range; == end unless ARENA__VM
+  u64 keep;  // ARENA__VM: bytes left committed by Arena__reset(); rest goes back to the OS
+  u8* dirty;  // high-water mark; bytes at/after max(dirty, pos) are known zero
+  u32 flags;
+  ArenaBacking backing;
+#ifdef ARENA__INSTRUMENTED
+  ArenaStats* stats;  // calloc'd by the first push
+#endif
 } Arena;
 
+// saved arena position; ArenaTemp__end() releases everything pushed since begin
+typedef struct {
+  Arena* arena;
+  u8* pos;
+} ArenaTemp;
+
 #include "common/Arena.c"  // IWYU pragma: keep
 
+// Atomics
+
+// NOTE: --std=c99 has no <stdatomic.h>; these wrap the GCC/Clang __atomic builtins
+#define Atomic__load(p) __atomic_load_n((p), __ATOMIC_ACQUIRE)
+#define Atomic__loadRelaxed(p) __atomic_load_n((p), __ATOMIC_RELAXED)
+#define Atomic__store(p, v) __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+#define Atomic__storeRelaxed(p, v) __atomic_store_n((p), (v), __ATOMIC_RELAXED)
+#define Atomic__add(p, v) __atomic_fetch_add((p), (v), __ATOMIC_ACQ_REL)
+#define Atomic__sub(p, v) __atomic_fetch_sub((p), (v), __ATOMIC_ACQ_REL)
+#define Atomic__xchg(p, v) __atomic_exchange_n((p), (v), __ATOMIC_ACQ_REL)
+// weak CAS; on failure, *(expected) is updated with the current value
+#define Atomic__cas(p, expected, desired) \
+  __atomic_compare_exchange_n(            \
+      (p),                                \
+      (expected),                         \
+      (desired),                          \
+      true,                               \
+      __ATOMIC_ACQ_REL,                   \
+      __ATOMIC_ACQUIRE)
+#define Atomic__fence() __atomic_thread_fence(__ATOMIC_SEQ_CST)
+
+// spin-wait hint (reduces power + pipeline flush cost while busy-waiting)
+#if defined(__x86_64__) || defined(__i386__)
+#define Atomic__pause() __asm__ __volatile__("pause")
+#elif defined(__aarch64__)
+#define Atomic__pause() __asm__ __volatile__("yield")
+#else
+#define Atomic__pause()
+#endif
+
 // Threads
 
 #ifdef _WIN32
@@ -129,6 +235,8 @@ typedef struct {
 typedef THREAD_FN_RET (*thread_fn_t)(THREAD_FN_PARAM1);
 #else
 #include <pthread.h>  // POSIX (Linux, macOS)
+#include <sched.h>  // SCHED_FIFO, cpu_set_t
+#include <sys/mman.h>  // mlockall()
 
 #define THREAD_FN_RET void*
 #define THREAD_FN_RET_VAL (NULL)
@@ -147,7 +255,104 @@ typedef THREAD_FN_RET (*thread_fn_t)(THREAD_FN_PARAM1);
 
 #define MAX_THREADS (64)
 
-#include "common/Thread.c"  // IWYU pragma: keep
+#define THREAD__ARENA_SZ (1024 * 1024)  // per-thread long-term arena
+#define THREAD__FRAME_ARENA_SZ (256 * 1024)  // per-thread temporary arena
+#define THREAD__SCRATCH_SZ (64ULL * 1024 * 1024)  // per-thread scratch reserve (x2)
+#define THREAD__SCRATCH_KEEP (256 * 1024)  // scratch stays committed up to this
+#define THREAD__PREFAULT_STACK_SZ (64 * 1024)  // stack touched up front by ThreadAttr.prefault
+#define THREAD__ANY (-1)  // ThreadAttr core/numaNode: no preference
+
+// placement + scheduling for Thread__createAttr(); start from THREAD_ATTR_DEFAULT
+typedef struct {
+  s32 core;  // pin to this CPU (THREAD__ANY = let the OS migrate)
+  s32 priority;  // SCHED_FIFO priority 1-99 (0 = normal time-sharing)
+  s32 numaNode;  // prefer this node for the thread's memory (THREAD__ANY = first-touch)
+  bool prefault;  // touch every page of the thread's arenas + stack before fn runs
+} ThreadAttr;
+#define THREAD_ATTR_DEFAULT                                                                      \
+  ((ThreadAttr){.core = THREAD__ANY, .priority = 0, .numaNode = THREAD__ANY, .prefault = false})
+
+// ThreadCtx.flags; which ThreadAttr requests the OS granted
+#define THREAD__PINNED (1 << 0)
+#define THREAD__REALTIME (1 << 1)
+#define THREAD__NUMA_LOCAL (1 << 2)
+#define THREAD__PREFAULTED (1 << 3)
+
+// per-thread engine context; Arena__push() is not thread-safe,
+// so each thread allocates only from its own arenas
+typedef struct {
+  Arena* arena;  // long-term allocations (main thread: _G->arena)
+  Arena* frameArena;  // temporary allocations (main thread: _G->frameArena)
+  Arena* scratch[2];  // function-local temporaries; only via Scratch__begin()
+  u32 id;  // 0 = main thread
+  u32 flags;  // THREAD__PINNED | ... (attributes actually applied)
+} ThreadCtx;
+
+// #include "common/Thread.c"  // IWYU pragma: keep
+
+// Sync
+
+#ifdef __linux__
+#include <sys/syscall.h>  // SYS_futex
+#include <unistd.h>  // syscall()
+#endif
+
+#define SYNC__SPIN_CT (128)  // busy-wait attempts before sleeping in the kernel
+
+// adaptive mutex; spins briefly, then sleeps on a futex. zero-init = unlocked
+typedef struct {
+  u32 state;  // 0 = unlocked, 1 = locked, 2 = locked + waiters
+} SyncMutex;
+
+// FIFO spinlock for very short critical sections. zero-init = unlocked
+typedef struct {
+  u32 next;  // next ticket to hand out
+  u32 serving;  // ticket allowed in
+} TicketLock;
+
+// writer-preferring reader-writer lock. zero-init = unlocked
+typedef struct {
+  u32 state;  // reader count | RWLOCK__WRITER | RWLOCK__WRITER_WAIT
+  u32 waiters;  // threads asleep on state
+} RWLock;
+
+// auto-reset event; Event__set() releases one waiter. zero-init = unsignaled
+typedef struct {
+  u32 signaled;
+  u32 waiters;  // threads asleep on signaled
+} Event;
+
+// #include "common/Sync.c"  // IWYU pragma: keep
+
+// StateBuf (versioned multi-buffer; one writer, any number of readers)
+
+#define STATEBUF__MAX_CT (4)  // buffers; 3 lets the writer never wait on one slow reader
+
+typedef struct {
+  u32 refs;  // readers currently holding this buffer
+  u8 _pad[CACHELINE_SZ - sizeof(u32)];  // readers of different buffers don't share a line
+} StateBuf__Ref;
+
+typedef struct {
+  StateBuf__Ref refs[STATEBUF__MAX_CT];
+  u8* bufs[STATEBUF__MAX_CT];
+  u64 versions[STATEBUF__MAX_CT];  // tick each buffer holds (0 = never written)
+  u32 ct;  // buffers in use
+  u32 sz;  // bytes per buffer
+  u32 published;  // index readers pick up
+  u32 writing;  // index owned by the writer between begin() and publish()
+  u64 version;  // last published version
+  u64 stalls;  // times begin() found every back buffer held by readers
+} StateBuf;
+
+// read-only, consistent view of one published version
+typedef struct {
+  const void* data;
+  u64 version;
+  u32 idx;
+} StateView;
+
+// #include "common/StateBuf.c"  // IWYU pragma: keep
 
 // Profiler
 
@@ -185,17 +390,51 @@ Profiler profiler;
 
 #include "common/Profiler.c"  // IWYU pragma: keep
 
+// Pool (fixed-size slots carved from arena pages; intrusive free list)
+
+#define POOL__PAGE_SLOTS (256)  // slots carved per arena push when the free list runs dry
+#define POOL__CACHE_CT (64)  // PoolCache holds at most this many; returns half when full
+
+typedef struct Pool__Slot {
+  struct Pool__Slot* next;  // only meaningful while the slot is free
+} Pool__Slot;
+
+typedef struct {
+  Arena* arena;  // pages come from here and are never given back
+  Pool__Slot* free;
+  u32 slotSz;
+  u32 pageSlots;
+  u64 live;  // slots handed out (slots parked in a PoolCache count as live)
+  u64 carved;  // slots ever carved from the arena; bounds memory use
+  SyncMutex lock;  // guards the fields above for PoolCache refill/flush
+} Pool;
+
+// per-thread stash of free slots for one shared Pool. zero-init = empty
+typedef struct {
+  Pool__Slot* head;
+  u32 ct;
+} PoolCache;
+
+// typed wrapper; functions come from GENERIC_POOL_FNS (see Pool.c)
+#define GENERIC_POOL(N, T) \
+  typedef struct {         \
+    Pool pool;             \
+  } N
+
+// #include "common/Pool.c"  // IWYU pragma: keep
+
 // List
 
-#define GENERIC_LIST(N, T)   \
-  typedef struct N##__Node { \
-    struct N##__Node* next;  \
-    T data;                  \
-  } N##__Node;               \
-  typedef struct {           \
-    u32 len;                 \
-    N##__Node* head;         \
-    N##__Node* tail;         \
+#define GENERIC_LIST(N, T)                                                \
+  typedef struct N##__Node {                                              \
+    struct N##__Node* next;                                               \
+    T data;                                                               \
+  } N##__Node;                                                            \
+  typedef struct {                                                        \
+    u32 len;                                                              \
+    N##__Node* head;                                                      \
+    N##__Node* tail;                                                      \
+    Pool* pool; /* node source; NULL = caller's arena, never reclaimed */ \
   } N
 
 GENERIC_LIST(List, void*);
@@ -208,7 +447,60 @@ typedef struct {
   u32 i;
 } ListIt;  // List Iterator
 
-#include "common/List.c"  // IWYU pragma: keep
+// #include "common/List.c"  // IWYU pragma: keep
+
+// Vec (contiguous, arena-backed dynamic array)
+
+#define GENERIC_VEC(N, T)                                                \
+  typedef struct {                                                       \
+    T* data;                                                             \
+    u32 len;                                                             \
+    u32 cap;                                                             \
+    Arena* arena; /* grows here; extends in place when data is on top */ \
+  } N;                                                                   \
+  typedef struct {                                                       \
+    N* vec;                                                              \
+    T* item; /* NULL before the first N##It__each() */                   \
+    u32 i;                                                               \
+  } N##It
+
+#include "common/Vec.c"  // IWYU pragma: keep
+
+// DList (intrusive doubly linked list; the link lives inside the element)
+
+// list head (sentinel) or a link embedded in an element. zero-init link = unlinked
+typedef struct DList {
+  struct DList* next;
+  struct DList* prev;
+} DList;
+
+#include "common/DList.c"  // IWYU pragma: keep
+
+// Heap (d-ary min-heap priority queue with handles)
+
+#define HEAP__D (4)  // children per node; shallower than binary, and siblings share a line
+#define HEAP__NONE (UINT32_MAX)  // invalid handle
+
+#define GENERIC_HEAP(N, T)                                                 \
+  typedef struct {                                                         \
+    T item;                                                                \
+    u32 handle;                                                            \
+  } N##__Node;                                                             \
+  typedef struct {                                                         \
+    N##__Node* nodes; /* heap order; [0] = min */                          \
+    u32* pos; /* handle -> index in nodes (HEAP__NONE = free handle) */    \
+    u32* spare; /* stack of free handles */                                \
+    u32 len;                                                               \
+    u32 cap;                                                               \
+    u32 spareCt;                                                           \
+    Arena* arena; /* grows here; old arrays are left to the arena reset */ \
+  } N
+
+#include "common/Heap.c"  // IWYU pragma: keep
+
+// Sort (introsort + radix kernels, generated per type)
+
+#include "common/Sort.c"  // IWYU pragma: keep
 
 // Buffers
 
@@ -216,6 +508,7 @@ typedef struct {
   // |                     |
   // 0      |      |       n
   u8 *data, *read, *write, *end;
+  u8* dirty;  // high-water mark of bytes that may be non-zero; SZ_reset() clears up to here
 } ByteBuffer;
 
 // #include "common/ByteBuffer.c"  // IWYU pragma: keep
@@ -225,8 +518,104 @@ typedef struct {
   u16 tail; /* Oldest item (aka start) */
 } RingBuf;  // Ring Buffer
 
+// typed ring; counters are free-running u32, index = counter & mask (no wasted slot)
+#define GENERIC_RING(N, T, CAP_LOG2) \
+  typedef struct {                   \
+    u32 head; /* next write */       \
+    u32 tail; /* oldest item */      \
+    T buf[1u << (CAP_LOG2)];         \
+  } N
+
 #include "common/Ring.c"  // IWYU pragma: keep
 
+// Queues (lock-free)
+
+// single-producer/single-consumer ring
+// counters are free-running u32; index = counter & mask (no wasted slot)
+#define GENERIC_SPSC(N, T, CAP_LOG2)               \
+  typedef struct {                                 \
+    u8 _pad0[CACHELINE_SZ];                        \
+    u32 head; /* next write (producer-owned) */    \
+    u32 tailCache; /* producer's last-seen tail */ \
+    u8 _pad1[CACHELINE_SZ - 2 * sizeof(u32)];      \
+    u32 tail; /* next read (consumer-owned) */     \
+    u32 headCache; /* consumer's last-seen head */ \
+    u8 _pad2[CACHELINE_SZ - 2 * sizeof(u32)];      \
+    T buf[1u << (CAP_LOG2)];                       \
+  } N
+
+// bounded multi-producer/single-consumer ring
+// per-cell sequence numbers (Vyukov); producers claim slots by CAS on head
+#define GENERIC_MPSC(N, T, CAP_LOG2)                 \
+  typedef struct {                                   \
+    u32 seq;                                         \
+    T data;                                          \
+  } N##__Cell;                                       \
+  typedef struct {                                   \
+    u8 _pad0[CACHELINE_SZ];                          \
+    u32 head; /* next write (shared by producers) */ \
+    u8 _pad1[CACHELINE_SZ - sizeof(u32)];            \
+    u32 tail; /* next read (consumer-owned) */       \
+    u8 _pad2[CACHELINE_SZ - sizeof(u32)];            \
+    N##__Cell buf[1u << (CAP_LOG2)];                 \
+  } N
+
+#include "common/Queue.c"  // IWYU pragma: keep
+
+// SlotMap (dense items + generational handles)
+
+#define SLOTMAP__NONE (UINT32_MAX)
+
+// stable reference to a SlotMap item; stale once the item is removed. zero-init = null
+typedef struct {
+  u32 idx;  // slot index
+  u32 gen;  // must match the slot's generation (0 = never valid)
+} SlotHandle;
+
+typedef struct {
+  u32 idx;  // live: index into dense; free: next free slot (SLOTMAP__NONE = end)
+  u32 gen;  // bumped on every remove, so old handles stop matching
+} SlotMap__Slot;
+
+#define GENERIC_SLOTMAP(N, T)                                           \
+  typedef struct {                                                      \
+    T* dense; /* live items, packed; iterate [0, len) */                \
+    u32* denseSlot; /* dense index -> slot index */                     \
+    SlotMap__Slot* slots;                                               \
+    u32 len;                                                            \
+    u32 cap;                                                            \
+    u32 slotCt; /* slots handed out at least once */                    \
+    u32 freeHead; /* most recently freed slot (SLOTMAP__NONE = none) */ \
+  } N
+
+#include "common/SlotMap.c"  // IWYU pragma: keep
+
+// HashMap (open addressing, Swiss-table control bytes)
+
+#ifdef __SSE2__
+#include <emmintrin.h>  // 16-byte control group compare
+#endif
+
+#define HASHMAP__GROUP (16)  // control bytes matched at once (one SSE2 register)
+#define HASHMAP__EMPTY (0x80)  // control byte: never used (stops probing)
+#define HASHMAP__DELETED (0xfe)  // control byte: tombstone (probing continues)
+
+#define GENERIC_HASHMAP(N, K, V)                                            \
+  typedef struct {                                                          \
+    K key;                                                                  \
+    V val;                                                                  \
+  } N##__Entry;                                                             \
+  typedef struct {                                                          \
+    u8* ctrl; /* per slot: EMPTY, DELETED, or low 7 bits of the key hash */ \
+    N##__Entry* slots;                                                      \
+    Arena* arena; /* grows here; old tables are left to the arena reset */  \
+    u32 cap; /* slots; power of 2, multiple of HASHMAP__GROUP */            \
+    u32 len;                                                                \
+    u32 growthLeft; /* inserts into EMPTY slots before the next rehash */   \
+  } N
+
+#include "common/HashMap.c"  // IWYU pragma: keep
+
 // Math
 
 // min, max, clamp
@@ -241,14 +630,152 @@ typedef struct {
   }
 #define Math__between(min, n, max) (((min) < (n)) && ((n) < (max)))
 
+// Parallel (data-parallel worker pool)
+
+#ifdef __linux__
+#include <unistd.h>  // sysconf()
+#endif
+
+#define PARALLEL__CHUNK_SZ (32 * 1024)  // default bytes per chunk (~L1d)
+#define PARALLEL__SCRATCH_SZ (64 * 1024)  // per-worker frame arena
+#define PARALLEL__MAX_ACC_SZ (CACHELINE_SZ * 2)  // max reduce result size
+
+typedef struct {
+  ARange2 range;  // this chunk's slice of the input (ptr = first element)
+  u32 begin, end;  // element indices within the full input
+  u32 worker;  // 0 = calling thread, 1..n = pool workers
+  Arena* scratch;  // per-worker frame arena; reset at the start of each job
+  void* acc;  // per-worker partial result (Parallel__reduce only)
+  void* userdata;
+} ParallelTask;
+
+typedef void (*Parallel__fn_t)(ParallelTask* task);
+typedef void (*Parallel__combine_t)(void* acc, const void* partial, void* userdata);
+
+// aligned, so every worker (and its acc) starts a cache line wherever `parallel` lands
+typedef struct __attribute__((aligned(CACHELINE_SZ))) {
+  u8 acc[PARALLEL__MAX_ACC_SZ];  // partial result; first so it owns its cache lines
+  Arena* scratch;
+  u32 lastGen;  // last job generation this worker joined
+  u8 _pad[CACHELINE_SZ - sizeof(Arena*) - sizeof(u32)];
+} ParallelWorker;
+
+typedef struct {
+  Thread threads[MAX_THREADS];
+  ParallelWorker workers[MAX_THREADS];  // [0] = calling thread
+  u32 workerCt;  // incl. calling thread
+
+  // current job (written only while no worker is busy)
+  ARange2 range;
+  u32 grain, chunkCt;
+  Parallel__fn_t fn;
+  void* userdata;
+
+  // sync
+  u32 state;  // (gen << 1) | running
+  u32 busy;  // workers inside the current job
+  u32 next;  // next chunk to claim
+  u32 done;  // chunks completed
+  Event wake;  // set when a job is published (or on quit)
+  bool quit;
+} Parallel;
+
+Parallel parallel;
+
+// #include "common/Parallel.c"  // IWYU pragma: keep
+
+// Ecs (sparse-set entity-component store)
+
+#define ECS__MAX_COMPONENTS (32)  // one bit each in EcsMask
+#define ECS__MAX_FIELDS (8)  // SoA columns per component
+#define ECS__NONE (UINT32_MAX)
+#define ECS__BIT(c) (1u << (c))
+
+typedef u32 EcsMask;  // set of component ids
+
+typedef struct {
+  u32 idx;
+  u32 gen;  // 0 = invalid handle
+} EcsEntity;
+
+// one component type: sparse set of entities + one dense column per field (SoA)
+typedef struct {
+  u32* sparse;  // entity idx -> row (ECS__NONE = absent)
+  u32* dense;  // row -> entity idx
+  u8* cols[ECS__MAX_FIELDS];  // row -> field value; each column starts on its own cache line
+  u16 fieldSz[ECS__MAX_FIELDS];
+  u32 fieldCt;
+  u32 len, cap;
+} EcsPool;
+
+typedef struct {
+  EcsPool pools[ECS__MAX_COMPONENTS];
+  u32 componentCt;
+  EcsMask* masks;  // entity idx -> components it has
+  u32* gens;  // entity idx -> current generation
+  u32* next;  // free-list links
+  u32 freeHead;  // ECS__NONE = no recycled idx
+  u32 slotCt;  // idx ever handed out
+  u32 len;  // live entities
+  u32 cap;  // max entities
+  Arena* arena;  // component columns live here
+} Ecs;
+
+// multi-component join cursor; visits entities having every component in mask
+typedef struct {
+  Ecs* ecs;
+  EcsMask mask;
+  u32 lead;  // smallest pool in mask; its dense rows drive the scan
+  u32 i, end;  // lead rows left to visit
+  u32 entity;  // current entity idx
+  u32 rows[ECS__MAX_COMPONENTS];  // current entity's row per component in mask
+} EcsJoin;
+
+typedef void (*Ecs__system_t)(EcsJoin* join, ParallelTask* task);
+
+// #include "common/Ecs.c"  // IWYU pragma: keep
+
+// Grid (spatial hash for proximity + interest management)
+
+#define GRID__NONE (UINT32_MAX)
+
+// uniform cells of cellSz, hashed into a fixed bucket table (unbounded world)
+typedef struct {
+  u32* heads;  // bucket -> first item (GRID__NONE = empty)
+  u32* next;  // item -> next in bucket
+  u32* prev;  // item -> prev in bucket
+  u32* bucket;  // item -> its bucket (GRID__NONE = not in grid)
+  s32 *cx, *cy;  // item -> cell; filters hash collisions
+  f32 *x, *y;  // item -> position
+  u32 bucketMask;
+  u32 cap;  // item ids are 0..cap-1 (e.g. entity idx)
+  u32 len;
+  f32 cellSz, invCellSz;
+} Grid;
+
+// one observer's visible set (e.g. per client); bits mirror ids
+typedef struct {
+  u32* ids;
+  u64* bits;
+  u32 len;
+} GridView;
+
+// what changed between two GridView__diff() calls
+typedef struct {
+  u32 *entered, *left, *stayed;
+  u32 enteredCt, leftCt, stayedCt;
+} GridDiff;
+
+#include "common/Grid.c"  // IWYU pragma: keep
+
 // Strings (Views)
 
 typedef enum {
   STR_STATIC = 0,  // immutable const char*
   STR_STACK = 1,  // mutable char*
   STR_MALLOC = 2,  // malloc() heap
-  STR_ARENA1 = 3,  // Arena__Push(_G.arena) heap
-  STR_ARENA2 = 4,  // Arena__Push(_G.frameArena) heap
+  STR_ARENA1 = 3,  // Arena__Push(ThreadCtx__get()->arena) heap
+  STR_ARENA2 = 4,  // Arena__Push(ThreadCtx__get()->frameArena) heap
 } Str8Lifetime;
 
 typedef struct {
@@ -261,6 +788,18 @@ typedef struct {
   Str8Lifetime life;  // lifetime
 } Str8;
 
+// interned string id; equal text <=> equal id
+typedef u32 StrId;
+#define STR8__ID_NONE (0)  // never interned
+
+GENERIC_HASHMAP(Str8Map, Str8, StrId);
+GENERIC_VEC(Str8Vec, Str8);
+
+typedef struct {
+  Str8Map ids;  // text -> id
+  Str8Vec strs;  // id -> text (in _G->arena); [0] = STR8__ID_NONE
+} Str8Table;
+
 // #include "common/String.c"  // IWYU pragma: keep
 
 // JSON
@@ -394,6 +933,8 @@ typedef struct {
   u8 cl_interp;  // lag compensation (ms)
   u64 lastPacket, lastSnapshot;
   void* userdata;
+  u32 id;  // connection id; key for this socket in replay logs
+  bool replay;  // stand-in for a recorded connection; writes skip the OS
 } Socket;
 
 typedef void (*Socket__alloc_t)(Socket** sock);
@@ -404,12 +945,109 @@ typedef void (*Socket__send_t)(Socket* sock, u8* buf, u32 len);
 
 // #include "common/Sock.c"  // IWYU pragma: keep
 
+// Fibers (stackful coroutines)
+
+#ifdef __linux__
+#include <sys/epoll.h>
+#endif
+
+#define FIBER__STACK_SZ (16 * 1024)  // default per-fiber stack
+#define FIBER__GUARD_SZ (ARENA__PAGE_SZ)  // PROT_NONE page below each stack; overflow faults
+
+typedef struct {
+  void* sp;  // saved stack pointer; callee-saved registers live on the stack
+} FiberCtx;
+
+typedef enum {
+  FIBER_FREE,
+  FIBER_READY,
+  FIBER_RUNNING,
+  FIBER_WAIT_IO,  // awaiting socket readiness
+  FIBER_SLEEP,
+  FIBER_DONE,
+} FiberState;
+
+typedef struct Fiber Fiber;
+typedef struct FiberSched FiberSched;
+typedef void (*Fiber__fn_t)(Fiber* fiber, void* userdata);
+
+struct Fiber {
+  FiberCtx ctx;
+  FiberState state;
+  Fiber__fn_t fn;
+  void* userdata;
+  u8* stack;  // from pool; stackSz bytes
+  s64 polledFd;  // fd registered with epoll (-1 = none)
+  u64 wakeAt;  // FIBER_SLEEP deadline (ms, Time__now())
+  FiberSched* sched;
+  Fiber* next;  // free list, run queue, or sleep list
+};
+
+struct FiberSched {
+  FiberCtx ctx;  // event loop context (resumed when a fiber yields)
+  Fiber* fibers;  // [cap]
+  u8* stacks;  // [cap * (FIBER__GUARD_SZ + stackSz)]; own mapping, not from the arena
+  u32 cap, stackSz, live;
+  Fiber* free;
+  Fiber *readyHead, *readyTail;
+  Fiber* sleeping;
+  s32 epollFd;
+};
+
+// Replay (tick input log)
+
+#define REPLAY__MAGIC (0x474c4b54)  // "TKLG"
+#define REPLAY__VERSION (2)  // 2: REPLAY_SESSION records
+#define REPLAY__SOCKETS_MIN (64)  // connections the id map holds before it first grows
+#define REPLAY__ARENA_RESERVE (256ULL * 1024 * 1024)  // driver scratch (id map); committed on use
+
+typedef enum {
+  REPLAY_TICK = 1,  // tick, now, seed
+  REPLAY_RECV = 2,  // socket id, len, bytes
+  REPLAY_CLOSE = 3,  // socket id
+  REPLAY_SESSION = 4,  // unix ts; a new process started recording (ids + ticks restart)
+} ReplayRecord;
+
+// append-only recorder (one per process)
+typedef struct {
+  FILE* file;
+  u64 bytes;  // written so far
+} Replay;
+
+// replay driver results; tick time covers message handlers + tick fn
+typedef struct {
+  u64 sessions, ticks, msgs, msgBytes;
+  u64 totalNs, maxNs;
+  u64 maxSession, maxTick;  // session (1-based) + tick number of the slowest tick
+} ReplayStats;
+
+// replay driver's stand-in for a recorded connection
+typedef struct {
+  Socket* sock;
+  bool owned;  // calloc'd by the driver (no onsockalloc hook)
+} Replay__Socket;
+
+GENERIC_HASHMAP(Replay__SocketMap, u64, Replay__Socket);
+
+typedef void (*Engine__tick_t)(void);
+
+// #include "common/Replay.c"  // IWYU pragma: keep
+
 // Engine
 
 typedef struct Engine__State {
   Arena* arena;  // long-term allocations
   Arena* frameArena;  // temporary allocations
 
+  // Tick (every input a tick consumes is recorded when replay != NULL)
+  u64 tick;  // current tick number
+  u64 now;  // ms; sampled once at tick start (use instead of Time__now() in game code)
+  u64 seed;  // RNG seed for this tick
+  Replay* replay;  // recorder; NULL = off
+
+  // Strings
+  Str8Table strings;  // interned text (Str8__intern)
+
   // Net
   Socket__alloc_t onsockalloc;
   Socket__accept_t onsockaccept;
@@ -417,6 +1055,9 @@ typedef struct Engine__State {
   Socket__recv_t onsockrecv;
   Socket__send_t onsocksend;
 
+  // Simulation
+  Ecs ecs;  // entities + components
+
   // Add engine-specific state variables here
 
 } Engine__State;
@@ -427,8 +1068,17 @@ Engine__State* _G = &(Engine__State){0};  // stack allocation in main thread
 // Includes (order matters)
 
 // clang-format off
+#include "common/Thread.c"  // IWYU pragma: keep
+#include "common/Sync.c"  // IWYU pragma: keep
+#include "common/Pool.c"  // IWYU pragma: keep
+#include "common/List.c"  // IWYU pragma: keep
+#include "common/StateBuf.c"  // IWYU pragma: keep
+#include "common/Parallel.c"  // IWYU pragma: keep
+#include "common/Ecs.c"  // IWYU pragma: keep
 #include "common/String.c"  // IWYU pragma: keep
 #include "common/ByteBuffer.c"  // IWYU pragma: keep
+#include "common/Replay.c"  // IWYU pragma: keep
 #include "common/Sock.c"  // IWYU pragma: keep
+#include "common/Fiber.c"  // IWYU pragma: keep
 #include "common/Json.c"  // IWYU pragma: keep
 // clang-format on
\ No newline at end of file
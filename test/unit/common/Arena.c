@@ -0,0 +1,297 @@
+#define UNIT_TEST
+
+#include "../../../src/unity.h"  // IWYU pragma: keep
+
+#define BENCH_SZ (64 * 1024 * 1024)
+#define BENCH_ROUNDS (20)
+
+// true if every byte of [p, p + sz) is zero
+static bool _Arena__isZero(const u8* p, u64 sz) {
+  for (u64 i = 0; i < sz; i++) {
+    if (0 != p[i]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// dirty `used` bytes, then time `reset` over BENCH_ROUNDS rounds
+// page refaults after a DONTNEED land in the next round's memset, outside the timed region
+// @returns avg ns per reset
+static u64 _Arena__benchReset(Arena* a, u64 used, void (*reset)(Arena*)) {
+  u64 total = 0;
+  for (u32 i = 0; i < BENCH_ROUNDS; i++) {
+    memset(Arena__push(a, used), 0xab, used);
+    u64 start = Time__perf_now();
+    reset(a);
+    total += Time__perf_now() - start;
+  }
+  return total / BENCH_ROUNDS;
+}
+
+// the reset SZ_reset()/Arena__zero() used to do: clear the whole committed buffer
+static void _Arena__memsetReset(Arena* a) {
+  memset(a->buf, 0, a->commit - a->buf);
+  a->pos = a->buf;
+}
+
+// @describe Arena
+// @tag common
+int main() {
+  _G->arena = Arena__allocZ(1024 * 1024);
+
+  // ---
+  // Scenario: pushZ only clears bytes below the high-water mark
+  {
+    Arena* a = Arena__alloc(4096);
+    u8* p = (u8*)Arena__pushZ(a, 4096);
+    ASSERT(_Arena__isZero(p, 4096));  // malloc'd arena starts fully dirty
+    memset(p, 0xff, 1000);
+    Arena__reset(a);
+    ASSERT(a->dirty == a->buf + 4096);
+
+    Arena__resetZ(a);
+    ASSERT(a->dirty == a->buf && _Arena__isZero(a->buf, 4096));
+    p = (u8*)Arena__pushZ(a, 100);
+    memset(p, 0xff, 100);
+    Arena__reset(a);
+    ASSERT(a->dirty == a->buf + 100);
+    p = (u8*)Arena__pushZ(a, 200);
+    ASSERT(_Arena__isZero(p, 200));
+    Arena__free(a);
+  }
+
+  // ---
+  // Scenario: ArenaTemp rollback raises the high-water mark
+  {
+    Arena* a = Arena__allocZ(4096);
+    ASSERT(a->dirty == a->buf && _Arena__isZero(a->buf, 4096));
+    ArenaTemp t = ArenaTemp__begin(a);
+    memset(Arena__push(a, 512), 0xff, 512);
+    ArenaTemp__end(t);
+    ASSERT(a->pos == a->buf && a->dirty == a->buf + 512);
+    u8* p = (u8*)Arena__pushZ(a, 1024);
+    ASSERT(_Arena__isZero(p, 1024));
+    Arena__free(a);
+  }
+
+  // ---
+  // Scenario: Reserved arena commits in ARENA__COMMIT_SZ steps; reset decommits down to keep
+  {
+    u64 keep = 2 * ARENA__COMMIT_SZ;
+    Arena* a = Arena__reserve(BENCH_SZ, keep);
+    ASSERT(NULL != a && a->commit == a->buf && BENCH_SZ == Arena__cap(a));
+    Arena__push(a, 1);
+    ASSERT(ARENA__COMMIT_SZ == a->commit - a->buf);
+    Arena__push(a, ARENA__COMMIT_SZ);  // 1 byte into the second step
+    ASSERT(2 * ARENA__COMMIT_SZ == a->commit - a->buf);
+    u64 sz = 5 * ARENA__COMMIT_SZ + 17;
+    memset(Arena__push(a, sz), 0xff, sz);
+    u64 used = Arena__used(a);
+    ASSERT(used == ARENA__COMMIT_SZ + 1 + sz);
+    u64 steps = (used + ARENA__COMMIT_SZ - 1) / ARENA__COMMIT_SZ;
+    ASSERT(steps * ARENA__COMMIT_SZ == (u64)(a->commit - a->buf));
+    ASSERT(BENCH_SZ - used == Arena__remain(a));
+
+    Arena__reset(a);
+    ASSERT(keep == (u64)(a->commit - a->buf) && a->dirty <= a->buf + keep);
+    u8* p = (u8*)Arena__pushZ(a, used);  // kept pages memset, decommitted ones refault as zero
+    ASSERT(_Arena__isZero(p, used));
+
+    a->keep = 0;
+    Arena__reset(a);
+    ASSERT(a->commit == a->buf && a->dirty == a->buf);
+    Arena__free(a);
+  }
+
+  // ---
+  // Scenario: Scratch__begin never hands back the conflicting scratch arena
+  {
+    ThreadCtx* ctx = ThreadCtx__get();
+    ASSERT(NULL != ctx->scratch[0] && NULL != ctx->scratch[1]);
+    ArenaTemp outer = Scratch__begin(NULL);
+    ASSERT(ctx->scratch[0] == outer.arena);
+    ArenaTemp inner = Scratch__begin(outer.arena);  // callee allocating into caller's scratch
+    ASSERT(ctx->scratch[1] == inner.arena);
+    ArenaTemp again = Scratch__begin(inner.arena);
+    ASSERT(ctx->scratch[0] == again.arena);
+    ASSERT(ctx->scratch[0] == Scratch__begin(_G->arena).arena);  // unrelated conflict
+
+    char* kept = (char*)Arena__push(outer.arena, 6);
+    memcpy(kept, "outer", 6);
+    ArenaTemp t = Scratch__begin(outer.arena);
+    Arena__push(t.arena, 1024);
+    Scratch__end(t);
+    ASSERT(inner.arena->pos == inner.pos && 0 == strcmp("outer", kept));
+    Scratch__end(again);
+    Scratch__end(inner);
+    Scratch__end(outer);
+    ASSERT(outer.arena->pos == outer.pos);
+  }
+
+  // ---
+  // Scenario: Arena__allocFlags falls back hugetlb -> THP -> 4KB pages; every backing is usable
+  {
+    u32 flags[] = {0, ARENA__POPULATE, ARENA__HUGE, ARENA__HUGE | ARENA__POPULATE};
+    for (u32 i = 0; i < ARRAYSIZE(flags); i++) {
+      u64 sz = 3 * 1024 * 1024 + 5;
+      Arena* a = Arena__allocFlags(sz, flags[i]);
+      ASSERT(NULL != a);
+      const char* backing = Arena__backing(a);
+      ASSERT(NULL != backing && 0 != backing[0] && 0 != strcmp("?", backing));
+      ASSERT(a->flags & ARENA__MAPPED);
+      ASSERT(Arena__cap(a) >= sz && 0 == Arena__cap(a) % ARENA__PAGE_SZ);
+      if (flags[i] & ARENA__HUGE) {
+        ASSERT(0 == Arena__cap(a) % ARENA__HUGE_PAGE_SZ);
+        ASSERT(ARENA_HEAP != a->backing);  // hugetlb, THP, or 4KB if madvise was refused
+      } else {
+        ASSERT(ARENA_PAGES == a->backing);
+      }
+      ASSERT(!!(flags[i] & ARENA__POPULATE) == !!(a->flags & ARENA__POPULATED));
+
+      u8* p = (u8*)Arena__pushZ(a, sz);
+      ASSERT(NULL != p && _Arena__isZero(p, sz));
+      memset(p, 0xff, sz);
+      Arena__resetZ(a);
+      ASSERT(_Arena__isZero(a->buf, sz));
+      LOG_DEBUGF("allocFlags(0x%x): %s", flags[i], backing);
+      Arena__free(a);
+    }
+  }
+
+#ifdef __linux__
+  // ---
+  // Scenario: resetZ keeps prefaulted / huge-page backing resident (memset, no DONTNEED)
+  {
+    u32 flags[] = {ARENA__POPULATE, ARENA__HUGE};
+    for (u32 i = 0; i < ARRAYSIZE(flags); i++) {
+      u64 sz = 4 * ARENA__DONTNEED_MIN;  // large enough to take the DONTNEED path otherwise
+      Arena* a = Arena__allocFlags(sz, flags[i]);
+      ASSERT(NULL != a);
+      ArenaBacking backing = a->backing;
+      u32 aflags = a->flags;
+      memset(Arena__push(a, sz), 0xff, sz);
+      Arena__resetZ(a);
+      ASSERT(backing == a->backing && aflags == a->flags);
+      unsigned char resident[4 * ARENA__DONTNEED_MIN / ARENA__PAGE_SZ];
+      s32 rc = mincore(a->buf, sz, resident);
+      ASSERT(0 == rc);
+      u32 dropped = 0;
+      for (u32 p = 0; p < ARRAYSIZE(resident); p++) {
+        dropped += !(resident[p] & 1);
+      }
+      ASSERT(0 == dropped);  // before reading it back, which would refault dropped pages
+      ASSERT(_Arena__isZero(a->buf, sz));
+      Arena__free(a);
+    }
+  }
+#endif
+
+  // ---
+  // Scenario: resetZ on a reserved arena hands back zero pages
+  {
+    Arena* a = Arena__reserve(BENCH_SZ, ARENA__KEEP_ALL);
+    ASSERT(NULL != a);
+    u64 sz = ARENA__DONTNEED_MIN * 4 + 123;  // unaligned tail is memset
+    memset(Arena__push(a, sz), 0xff, sz);
+    Arena__resetZ(a);
+    ASSERT(a->pos == a->buf && a->dirty == a->buf);
+    ASSERT(_Arena__isZero(a->buf, sz + 4096));
+    u8* p = (u8*)Arena__pushZ(a, 64);
+    ASSERT(_Arena__isZero(p, 64));
+    Arena__free(a);
+  }
+
+  // ---
+  // Scenario: ByteBuffer reset/defrag keep bytes past write zero
+  {
+    ByteBuffer b;
+    SZ_alloc(_G->arena, &b, 64);
+    ASSERT(_Arena__isZero(b.data, 64));
+    memcpy(b.write, "hello world", 11);
+    b.write += 11;
+    b.read += 6;
+    SZ_defrag(&b);
+    ASSERT(5 == b.write - b.read && 0 == memcmp(b.data, "world", 5));
+    ASSERT(_Arena__isZero(b.write, b.end - b.write));
+    SZ_reset(&b);
+    ASSERT(_Arena__isZero(b.data, 64));
+
+    // wrapped storage: reset clears the whole span, not just [data, write)
+    u8 raw[32];
+    memset(raw, 0xff, sizeof(raw));
+    SZ_wrap(&b, raw, 4, sizeof(raw));
+    b.read += 2;
+    SZ_defrag(&b);
+    SZ_reset(&b);
+    ASSERT(_Arena__isZero(raw, sizeof(raw)));
+  }
+
+  // ---
+  // Scenario: Aligned + typed pushes skip padding; cache-line blocks own whole lines
+  {
+    typedef struct {
+      u8 tag;
+      f64 v;
+    } Sample;
+    Arena* a = Arena__alloc(4096);
+    Arena__push(a, 3);  // knock pos off alignment
+    u8* p = (u8*)Arena__pushAligned(a, 10, 16);
+    ASSERT(0 == (uintptr_t)p % 16);
+    Sample* s = Arena__pushStruct(a, Sample);
+    ASSERT(0 == (uintptr_t)s % _Alignof(Sample) && (u8*)s >= p + 10);
+    u64* arr = Arena__pushArrayZ(a, u64, 8);
+    ASSERT(0 == (uintptr_t)arr % _Alignof(u64) && _Arena__isZero((u8*)arr, 64));
+    u8* line = (u8*)Arena__pushCacheline(a, 1);
+    ASSERT(0 == (uintptr_t)line % CACHELINE_SZ && a->pos == line + CACHELINE_SZ);
+    Arena__free(a);
+  }
+
+#ifdef ARENA__INSTRUMENTED
+  // ---
+  // Scenario: Instrumentation attributes pushes to call sites, tracks peak + reset history
+  {
+    Arena* a = Arena__alloc(64 * 1024);
+    for (u32 tick = 0; tick < 4; tick++) {
+      for (u32 i = 0; i <= tick; i++) {
+        Arena__push(a, 1000);  // grows by one push per tick
+      }
+      Arena__pushZ(a, 24);
+      Arena__reset(a);
+    }
+    ArenaStats* s = a->stats;
+    ASSERT(NULL != s && 2 == s->siteCt && 14 == s->pushes);
+    ASSERT(4024 == s->peak && 4 == s->resets);
+    ASSERT(1024 == s->history[0] && 4024 == s->history[3]);
+    u64 bytes = 0;
+    for (u32 i = 0; i < ARENA__MAX_SITES; i++) {
+      bytes += s->sites[i].bytes;
+    }
+    ASSERT(10 * 1000 + 4 * 24 == bytes);
+    Arena__printf(a, "test");
+    Arena__free(a);
+  }
+#endif
+
+  // ---
+  // Scenario: Benchmark resetZ vs full memset, 64MB reserved arena
+  {
+    Arena* a = Arena__reserve(BENCH_SZ, ARENA__KEEP_ALL);
+    ASSERT(NULL != a);
+    memset(Arena__push(a, BENCH_SZ), 0, BENCH_SZ);  // commit everything up front
+    Arena__resetZ(a);
+    u64 used[] = {4 * 1024, 64 * 1024, 1024 * 1024, 16 * 1024 * 1024, BENCH_SZ};
+    for (u32 i = 0; i < ARRAYSIZE(used); i++) {
+      u64 memsetNs = _Arena__benchReset(a, used[i], _Arena__memsetReset);
+      u64 resetZNs = _Arena__benchReset(a, used[i], Arena__resetZ);
+      LOG_DEBUGF(
+          "reset %8llu KB used: memset %8llu us  resetZ %8llu us",
+          used[i] / 1024,
+          Time__us(memsetNs),
+          Time__us(resetZNs));
+    }
+    Arena__free(a);
+  }
+
+  return 0;
+}
\ No newline at end of file
@@ -0,0 +1,71 @@
+#define UNIT_TEST
+
+#include "../../../src/unity.h"  // IWYU pragma: keep
+
+typedef struct {
+  u32 id;
+  DList link;
+} Item;
+
+// ids in list order, as a base-10 number (1,2,3 -> 123)
+static u32 _DList__ids(DList* head) {
+  u32 r = 0;
+  DLIST__EACH(link, head) {
+    r = r * 10 + DList__entry(link, Item, link)->id;
+  }
+  return r;
+}
+
+// @describe DList
+// @tag common
+int main() {
+  // ---
+  // Scenario: Push, remove by element, pop
+  {
+    Item items[5] = {{1}, {2}, {3}, {4}, {5}};
+    DList head;
+    DList__init(&head);
+    ASSERT(DList__empty(&head) && NULL == DList__popFront(&head));
+    ASSERT(!DList__linked(&items[0].link));  // zero-init = unlinked
+
+    for (u32 i = 1; i < 4; i++) {
+      DList__pushBack(&head, &items[i].link);
+    }
+    DList__pushFront(&head, &items[0].link);
+    ASSERT(1234 == _DList__ids(&head) && 4 == DList__len(&head));
+
+    DList__remove(&items[2].link);
+    DList__remove(&items[2].link);  // second remove is a no-op
+    ASSERT(124 == _DList__ids(&head) && !DList__linked(&items[2].link));
+    DList__insertBefore(&items[3].link, &items[4].link);
+    ASSERT(1254 == _DList__ids(&head));
+
+    ASSERT(&items[0].link == DList__popFront(&head));
+    ASSERT(&items[3].link == DList__popBack(&head));
+    ASSERT(25 == _DList__ids(&head));
+  }
+
+  // ---
+  // Scenario: Remove while iterating; splice buckets
+  {
+    Item items[6] = {{1}, {2}, {3}, {4}, {5}, {6}};
+    DList a, b;
+    DList__init(&a);
+    DList__init(&b);
+    for (u32 i = 0; i < 6; i++) {
+      DList__pushBack(i < 3 ? &a : &b, &items[i].link);
+    }
+    DLIST__EACH(link, &a) {
+      if (0 == DList__entry(link, Item, link)->id % 2) {
+        DList__remove(link);
+      }
+    }
+    ASSERT(13 == _DList__ids(&a));
+    DList__splice(&a, &b);
+    ASSERT(13456 == _DList__ids(&a) && DList__empty(&b));
+    DList__splice(&a, &b);  // empty src
+    ASSERT(13456 == _DList__ids(&a));
+  }
+
+  return 0;
+}
\ No newline at end of file
@@ -0,0 +1,148 @@
+#define UNIT_TEST
+
+#include "../../../src/unity.h"  // IWYU pragma: keep
+
+enum { POS, VEL, TAG };
+enum { X, Y };
+
+#define BENCH_CT (100000)
+
+static u16 _xy[] = {sizeof(f32), sizeof(f32)};
+static u16 _tag[] = {sizeof(u32)};
+
+// pos += vel
+static void _Move__system(EcsJoin* j, ParallelTask* task) {
+  f32 dt = *(f32*)task->userdata;
+  while (EcsJoin__next(j)) {
+    ECS__FIELD(j, POS, X, f32) += ECS__FIELD(j, VEL, X, f32) * dt;
+    ECS__FIELD(j, POS, Y, f32) += ECS__FIELD(j, VEL, Y, f32) * dt;
+  }
+}
+
+// @describe Ecs
+// @tag common
+int main() {
+  _G->arena = Arena__allocZ(16 * 1024 * 1024);
+  bool pool = Parallel__init(2);
+  ASSERT(pool);
+
+  // ---
+  // Scenario: Add, lookup and remove components; rows stay packed
+  {
+    Ecs ecs;
+    bool ok = Ecs__init(&ecs, _G->arena, 8);
+    ASSERT(ok);
+    u32 pos = Ecs__component(&ecs, _xy, 2, 0);
+    u32 vel = Ecs__component(&ecs, _xy, 2, 0);
+    ASSERT(POS == pos && VEL == vel);
+    EcsEntity a = Ecs__create(&ecs), b = Ecs__create(&ecs), c = Ecs__create(&ecs);
+    Ecs__add(&ecs, a, POS);
+    u32 rb = Ecs__add(&ecs, b, POS);
+    u32 rc = Ecs__add(&ecs, c, POS);
+    ECS__COL(&ecs, POS, X, f32)[rb] = 2.0f;
+    ECS__COL(&ecs, POS, X, f32)[rc] = 3.0f;
+    u32 again = Ecs__add(&ecs, c, POS);
+    ASSERT(rc == again);  // already has it
+    ASSERT(3 == ecs.pools[POS].len && ECS__NONE == Ecs__row(&ecs, a, VEL));
+
+    bool removed = Ecs__remove(&ecs, a, POS);
+    bool twice = Ecs__remove(&ecs, a, POS);
+    ASSERT(removed && !twice);
+    ASSERT(2 == ecs.pools[POS].len);
+    ASSERT(0 == Ecs__row(&ecs, c, POS));  // last row moved into the hole, with its fields
+    ASSERT(3.0f == ECS__COL(&ecs, POS, X, f32)[Ecs__row(&ecs, c, POS)]);
+    ASSERT(2.0f == ECS__COL(&ecs, POS, X, f32)[Ecs__row(&ecs, b, POS)]);
+  }
+
+  // ---
+  // Scenario: Destroyed entities lose their components; stale handles stay dead
+  {
+    Ecs ecs;
+    Ecs__init(&ecs, _G->arena, 2);
+    Ecs__component(&ecs, _xy, 2, 0);
+    EcsEntity a = Ecs__create(&ecs);
+    Ecs__create(&ecs);
+    EcsEntity full = Ecs__create(&ecs);
+    ASSERT(0 == full.gen && !Ecs__alive(&ecs, full));
+
+    Ecs__add(&ecs, a, POS);
+    bool destroyed = Ecs__destroy(&ecs, a);
+    bool twice = Ecs__destroy(&ecs, a);
+    ASSERT(destroyed && !twice);
+    ASSERT(0 == ecs.pools[POS].len && 1 == ecs.len);
+    EcsEntity a2 = Ecs__create(&ecs);
+    ASSERT(a2.idx == a.idx && a2.gen != a.gen);
+    u32 row = Ecs__add(&ecs, a, POS);
+    ASSERT(!Ecs__alive(&ecs, a) && ECS__NONE == row);
+    ASSERT(0 == ecs.masks[a2.idx]);
+  }
+
+  // ---
+  // Scenario: Join visits only entities with every component
+  {
+    Ecs ecs;
+    Ecs__init(&ecs, _G->arena, 64);
+    Ecs__component(&ecs, _xy, 2, 0);
+    Ecs__component(&ecs, _xy, 2, 0);
+    Ecs__component(&ecs, _tag, 1, 0);
+    for (u32 i = 0; i < 30; i++) {
+      EcsEntity e = Ecs__create(&ecs);
+      Ecs__add(&ecs, e, POS);
+      if (0 == i % 3) {
+        u32 row = Ecs__add(&ecs, e, VEL);
+        ECS__COL(&ecs, VEL, X, f32)[row] = (f32)i;
+      }
+      if (0 == i % 2) {
+        u32 row = Ecs__add(&ecs, e, TAG);
+        ECS__COL(&ecs, TAG, 0, u32)[row] = i;
+      }
+    }
+    EcsJoin j = Ecs__join(&ecs, ECS__BIT(POS) | ECS__BIT(VEL));
+    ASSERT(VEL == j.lead);  // smaller pool drives the scan
+    u32 ct = 0;
+    while (EcsJoin__next(&j)) {
+      ASSERT((f32)j.entity == ECS__FIELD(&j, VEL, X, f32));
+      ct++;
+    }
+    ASSERT(10 == ct);
+
+    j = Ecs__join(&ecs, ECS__BIT(VEL) | ECS__BIT(TAG));  // i % 6 == 0
+    for (ct = 0; EcsJoin__next(&j); ct++) {
+      ASSERT(0 == ECS__FIELD(&j, TAG, 0, u32) % 6);
+    }
+    ASSERT(5 == ct);
+  }
+
+  // ---
+  // Scenario: System split across the worker pool touches every match once
+  {
+    Ecs ecs;
+    Ecs__init(&ecs, _G->arena, BENCH_CT);
+    Ecs__component(&ecs, _xy, 2, 0);
+    Ecs__component(&ecs, _xy, 2, 0);
+    for (u32 i = 0; i < BENCH_CT; i++) {
+      EcsEntity e = Ecs__create(&ecs);
+      Ecs__add(&ecs, e, POS);
+      u32 row = Ecs__add(&ecs, e, VEL);
+      ECS__COL(&ecs, VEL, X, f32)[row] = 1.0f;
+      ECS__COL(&ecs, VEL, Y, f32)[row] = 2.0f;
+    }
+    f32 dt = 0.5f;
+    u64 start = Time__perf_now();
+    Ecs__parallel(&ecs, ECS__BIT(POS) | ECS__BIT(VEL), 1024, _Move__system, &dt);
+    u64 ns = Time__perf_now() - start;
+    f32* x = ECS__COL(&ecs, POS, X, f32);
+    f32* y = ECS__COL(&ecs, POS, Y, f32);
+    for (u32 i = 0; i < BENCH_CT; i++) {
+      ASSERT(0.5f == x[i] && 1.0f == y[i]);
+    }
+    LOG_DEBUGF(
+        "move system over %u entities (%u workers): %6llu us",
+        BENCH_CT,
+        Parallel__workers(),
+        Time__us(ns));
+  }
+
+  Parallel__shutdown();
+  return 0;
+}
\ No newline at end of file
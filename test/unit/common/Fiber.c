@@ -0,0 +1,292 @@
+#define UNIT_TEST
+
+#include "../../../src/unity.h"  // IWYU pragma: keep
+
+#include <sys/wait.h>  // waitpid()
+
+#define POOL_CT (4)
+
+static FiberSched _sched;
+static u32 _log[64];
+static u32 _logCt;
+
+static void _Test__log(u32 v) {
+  if (_logCt < ARRAYSIZE(_log)) {
+    _log[_logCt++] = v;
+  }
+}
+
+// poll until every fiber finished (bounded)
+static void _Test__drain(void) {
+  for (u32 i = 0; i < 10000 && 0 != FiberSched__poll(&_sched); i++) {
+    Time__sleep_ms(0 == i % 64 ? 1 : 0);
+  }
+  ASSERT(0 == _sched.live);
+}
+
+static void _Test__yielder(Fiber* f, void* userdata) {
+  for (u32 i = 0; i < 3; i++) {
+    _Test__log((u32)(uintptr_t)userdata);
+    Fiber__yield();
+  }
+}
+
+static void _Test__sleeper(Fiber* f, void* userdata) {
+  Fiber__sleep((u32)(uintptr_t)userdata);
+  _Test__log((u32)(uintptr_t)userdata);
+}
+
+static u32 _finished;
+
+static void _Test__short(Fiber* f, void* userdata) {
+  Fiber__yield();
+  _finished++;
+}
+
+#if defined(__x86_64__) && !defined(_WIN32)
+// load rbx, rbp, r12-r15 with seed+1..6, Fiber__yield(), count registers that changed
+u64 _Test__regsAcrossYield(u64 seed) __asm__("_Test__regsAcrossYield");
+// clang-format off
+__asm__(
+    ".text\n"
+    ".p2align 4\n"
+    "_Test__regsAcrossYield:\n"
+    "  pushq %rbp\n"
+    "  pushq %rbx\n"
+    "  pushq %r12\n"
+    "  pushq %r13\n"
+    "  pushq %r14\n"
+    "  pushq %r15\n"
+    "  pushq %rdi\n"  // seed; also realigns rsp to 16 for the call
+    "  leaq 1(%rdi), %rbx\n"
+    "  leaq 2(%rdi), %rbp\n"
+    "  leaq 3(%rdi), %r12\n"
+    "  leaq 4(%rdi), %r13\n"
+    "  leaq 5(%rdi), %r14\n"
+    "  leaq 6(%rdi), %r15\n"
+    "  call Fiber__yield\n"
+    "  movq (%rsp), %rdi\n"
+    "  xorl %eax, %eax\n"
+    "  leaq 1(%rdi), %rcx\n  cmpq %rcx, %rbx\n  setne %cl\n  movzbq %cl, %rcx\n  addq %rcx, %rax\n"
+    "  leaq 2(%rdi), %rcx\n  cmpq %rcx, %rbp\n  setne %cl\n  movzbq %cl, %rcx\n  addq %rcx, %rax\n"
+    "  leaq 3(%rdi), %rcx\n  cmpq %rcx, %r12\n  setne %cl\n  movzbq %cl, %rcx\n  addq %rcx, %rax\n"
+    "  leaq 4(%rdi), %rcx\n  cmpq %rcx, %r13\n  setne %cl\n  movzbq %cl, %rcx\n  addq %rcx, %rax\n"
+    "  leaq 5(%rdi), %rcx\n  cmpq %rcx, %r14\n  setne %cl\n  movzbq %cl, %rcx\n  addq %rcx, %rax\n"
+    "  leaq 6(%rdi), %rcx\n  cmpq %rcx, %r15\n  setne %cl\n  movzbq %cl, %rcx\n  addq %rcx, %rax\n"
+    "  popq %rdi\n"
+    "  popq %r15\n"
+    "  popq %r14\n"
+    "  popq %r13\n"
+    "  popq %r12\n"
+    "  popq %rbx\n"
+    "  popq %rbp\n"
+    "  ret\n");
+// clang-format on
+
+static u32 _regErrors, _fpErrors;
+
+// each fiber holds its own integer registers + FP control state across a switch
+static void _Test__regs(Fiber* f, void* userdata) {
+  u32 seed = (u32)(uintptr_t)userdata;
+  u32 mxcsr = 0x1F80 | ((seed & 3) << 13);  // rounding mode differs per fiber
+  u16 cw = 0x037F | (u16)((seed & 3) << 10);
+  __asm__ volatile("ldmxcsr %0" : : "m"(mxcsr));
+  __asm__ volatile("fldcw %0" : : "m"(cw));
+  for (u32 i = 0; i < 3; i++) {
+    _regErrors += (u32)_Test__regsAcrossYield((u64)seed << 32);
+  }
+  u32 mxcsr2 = 0;
+  u16 cw2 = 0;
+  __asm__ volatile("stmxcsr %0" : "=m"(mxcsr2));
+  __asm__ volatile("fnstcw %0" : "=m"(cw2));
+  _fpErrors += (mxcsr2 != mxcsr) + (cw2 != cw);
+  mxcsr = 0x1F80;  // restore defaults before returning to the event loop
+  cw = 0x037F;
+  __asm__ volatile("ldmxcsr %0" : : "m"(mxcsr));
+  __asm__ volatile("fldcw %0" : : "m"(cw));
+}
+#endif
+
+static volatile u32 _overflowDepth = UINT32_MAX;  // far past any stack size
+
+// recurse until the stack runs out
+static u32 _Test__recurse(u32 depth) {
+  volatile u8 frame[512];
+  frame[0] = (u8)depth;
+  return depth >= _overflowDepth ? 0 : frame[0] + _Test__recurse(depth + 1);
+}
+
+static void _Test__overflow(Fiber* f, void* userdata) {
+  _Test__recurse(0);
+}
+
+// socketpair end as a connected, non-blocking Socket
+static void _Test__pair(Socket* a, Socket* b) {
+  int fds[2];
+  int rc = socketpair(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0, fds);
+  ASSERT(0 == rc);
+  memset(a, 0, sizeof(Socket));
+  memset(b, 0, sizeof(Socket));
+  a->_nix_socket = (u64)fds[0];
+  b->_nix_socket = (u64)fds[1];
+  a->state = b->state = SOCKET_CONNECTED;
+}
+
+static Socket _a, _b, _c, _d;
+static s32 _got;
+static s64 _polledAfterClose;
+static bool _release;
+
+// read until the peer hangs up, then linger until released
+static void _Test__readToClose(Fiber* f, void* userdata) {
+  u8 buf[16];
+  while (Fiber__read(&_a, buf, sizeof(buf)) > 0) {
+    _Test__log(buf[0]);
+  }
+  _polledAfterClose = f->polledFd;
+  while (!_release) {
+    Fiber__yield();
+  }
+}
+
+// read once from _c (whose fd number may be one just closed)
+static void _Test__readOnce(Fiber* f, void* userdata) {
+  u8 buf[16];
+  _got = Fiber__read(&_c, buf, sizeof(buf));
+}
+
+static void _Test__writer(Fiber* f, void* userdata) {
+  Fiber__write(&_b, (const u8*)"x", 1);
+}
+
+// @describe Fiber
+// @tag common
+int main() {
+  _G->arena = Arena__allocZ(1024 * 1024);
+  bool ok = FiberSched__init(&_sched, _G->arena, POOL_CT, 0);
+  ASSERT(ok);
+
+  // ---
+  // Scenario: Yield round-robins ready fibers in spawn order
+  {
+    _logCt = 0;
+    for (u32 i = 0; i < 3; i++) {
+      FiberSched__spawn(&_sched, _Test__yielder, (void*)(uintptr_t)i);
+    }
+    _Test__drain();
+    u32 expect[] = {0, 1, 2, 0, 1, 2, 0, 1, 2};
+    ASSERT(9 == _logCt && 0 == memcmp(expect, _log, sizeof(expect)));
+  }
+
+  // ---
+  // Scenario: Sleepers wake in deadline order, not spawn order
+  {
+    _logCt = 0;
+    u32 ms[] = {30, 10, 20};
+    for (u32 i = 0; i < 3; i++) {
+      FiberSched__spawn(&_sched, _Test__sleeper, (void*)(uintptr_t)ms[i]);
+    }
+    u64 start = Time__now();
+    _Test__drain();
+    ASSERT(Time__now() - start >= 30);
+    ASSERT(3 == _logCt && 10 == _log[0] && 20 == _log[1] && 30 == _log[2]);
+  }
+
+#if defined(__x86_64__) && !defined(_WIN32)
+  // ---
+  // Scenario: Callee-saved and FP control registers survive interleaved switches
+  {
+    _regErrors = _fpErrors = 0;
+    for (u32 i = 1; i <= 3; i++) {
+      FiberSched__spawn(&_sched, _Test__regs, (void*)(uintptr_t)i);
+    }
+    _Test__drain();
+    ASSERT(0 == _regErrors && 0 == _fpErrors);
+  }
+#endif
+
+  // ---
+  // Scenario: Spawn/finish/reclaim cycles many times past the pool size
+  {
+    _finished = 0;
+    for (u32 round = 0; round < 100; round++) {
+      for (u32 i = 0; i < POOL_CT; i++) {
+        Fiber* f = FiberSched__spawn(&_sched, _Test__short, NULL);
+        ASSERT(NULL != f);
+      }
+      ASSERT(NULL == FiberSched__spawn(&_sched, _Test__short, NULL));  // pool exhausted
+      _Test__drain();
+    }
+    ASSERT(100 * POOL_CT == _finished);
+  }
+
+  // ---
+  // Scenario: Socket read/write await readiness; close unregisters before the fd is reused
+  {
+    _logCt = 0;
+    _release = false;
+    _Test__pair(&_a, &_b);
+    u64 closedFd = _a._nix_socket;
+    FiberSched__spawn(&_sched, _Test__readToClose, NULL);
+    FiberSched__poll(&_sched);  // parks on _a (nothing to read yet)
+    ASSERT(1 == _sched.live);
+
+    FiberSched__spawn(&_sched, _Test__writer, NULL);
+    for (u32 i = 0; i < 10 && 0 == _logCt; i++) {
+      FiberSched__poll(&_sched);
+    }
+    ASSERT(1 == _logCt && 'x' == _log[0]);
+
+    close((int)_b._nix_socket);  // peer hangs up -> Fiber__read closes _a
+    for (u32 i = 0; i < 10 && SOCKET_CLOSED != _a.state; i++) {
+      FiberSched__poll(&_sched);
+    }
+    ASSERT(SOCKET_CLOSED == _a.state && -1 == _polledAfterClose);
+
+    // next socket gets the closed fd number; a fiber parks on it
+    _Test__pair(&_c, &_d);
+    ASSERT(closedFd == _c._nix_socket);
+    _got = 0;
+    FiberSched__spawn(&_sched, _Test__readOnce, NULL);
+    FiberSched__poll(&_sched);
+
+    // reclaiming the first fiber must not unregister the reused fd
+    _release = true;
+    FiberSched__poll(&_sched);
+    ASSERT(1 == _sched.live);
+    ssize_t w = write((int)_d._nix_socket, "y", 1);
+    ASSERT(1 == w);
+    for (u32 i = 0; i < 100 && 0 == _got; i++) {
+      FiberSched__poll(&_sched);
+      Time__sleep_ms(1);
+    }
+    ASSERT(1 == _got && 0 == _sched.live);
+    close((int)_c._nix_socket);
+    close((int)_d._nix_socket);
+  }
+
+  // ---
+  // Scenario: Stack overflow hits the guard page instead of the neighbouring fiber
+  {
+    Fiber* a = FiberSched__spawn(&_sched, _Test__short, NULL);
+    Fiber* b = FiberSched__spawn(&_sched, _Test__short, NULL);
+    ASSERT(NULL != a && NULL != b);
+    ASSERT(a->stack - b->stack == FIBER__GUARD_SZ + _sched.stackSz ||
+           b->stack - a->stack == FIBER__GUARD_SZ + _sched.stackSz);
+    _Test__drain();
+
+    pid_t pid = fork();
+    if (0 == pid) {
+      FiberSched__spawn(&_sched, _Test__overflow, NULL);
+      FiberSched__poll(&_sched);
+      _exit(0);  // unreachable when the guard works
+    }
+    s32 status = 0;
+    waitpid(pid, &status, 0);
+    ASSERT(WIFSIGNALED(status) && SIGSEGV == WTERMSIG(status));
+  }
+
+  FiberSched__free(&_sched);
+  ASSERT(NULL == _sched.stacks);
+  return 0;
+}
\ No newline at end of file
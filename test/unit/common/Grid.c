@@ -0,0 +1,157 @@
+#define UNIT_TEST
+
+#include "../../../src/unity.h"  // IWYU pragma: keep
+
+#define ITEM_CT (10000)
+#define CLIENT_CT (100)
+#define WORLD_SZ (1000.0f)
+#define VIEW_R (50.0f)
+
+static bool _has(const u32* ids, u32 ct, u32 id) {
+  for (u32 i = 0; i < ct; i++) {
+    if (ids[i] == id) {
+      return true;
+    }
+  }
+  return false;
+}
+
+static f32 _rand(u32* seed) {
+  *seed = *seed * 1664525u + 1013904223u;
+  return (f32)(*seed >> 8) / (f32)(1u << 24);
+}
+
+// @describe Grid
+// @tag common
+int main() {
+  _G->arena = Arena__allocZ(16 * 1024 * 1024);
+
+  // ---
+  // Scenario: Insert, move, remove; queries see current positions
+  {
+    Grid g;
+    bool ok = Grid__init(&g, _G->arena, 16, 8, 10.0f);
+    ASSERT(ok);
+    Grid__insert(&g, 1, 5.0f, 5.0f);
+    Grid__insert(&g, 2, 15.0f, 5.0f);
+    Grid__insert(&g, 3, -25.0f, -5.0f);  // negative cells
+    ASSERT(3 == g.len);
+
+    u32 out[16];
+    u32 ct = Grid__queryAabb(&g, 0.0f, 0.0f, 20.0f, 10.0f, out, 16);
+    ASSERT(2 == ct && _has(out, ct, 1) && _has(out, ct, 2));
+    ct = Grid__queryRadius(&g, -24.0f, -4.0f, 2.0f, out, 16);
+    ASSERT(1 == ct && 3 == out[0]);
+
+    bool moved = Grid__move(&g, 2, 6.0f, 6.0f);  // same cell as 1
+    ASSERT(moved && 3 == g.len);
+    ct = Grid__queryRadius(&g, 5.5f, 5.5f, 1.0f, out, 16);
+    ASSERT(2 == ct);
+    ct = Grid__queryAabb(&g, 10.0f, 0.0f, 20.0f, 10.0f, out, 16);
+    ASSERT(0 == ct);
+
+    bool removed = Grid__remove(&g, 1);
+    bool twice = Grid__remove(&g, 1);
+    bool ghost = Grid__move(&g, 1, 0.0f, 0.0f);
+    ASSERT(removed && !twice && !ghost && 2 == g.len);
+    ct = Grid__queryRadius(&g, 5.5f, 5.5f, 1.0f, out, 16);
+    ASSERT(1 == ct && 2 == out[0]);
+    Grid__insert(&g, 2, -24.0f, -6.0f);  // insert of a present id moves it
+    ASSERT(2 == g.len);
+    ct = Grid__queryRadius(&g, -24.0f, -4.0f, 3.0f, out, 16);
+    ASSERT(2 == ct);
+  }
+
+  // ---
+  // Scenario: Queries match brute force, despite few buckets (many collisions)
+  {
+    Grid g;
+    Grid__init(&g, _G->arena, 1000, 4, 8.0f);
+    u32 seed = 3;
+    for (u32 i = 0; i < 1000; i++) {
+      Grid__insert(&g, i, _rand(&seed) * 200.0f - 100.0f, _rand(&seed) * 200.0f - 100.0f);
+    }
+    u32 out[1000];
+    for (u32 q = 0; q < 50; q++) {
+      f32 x = _rand(&seed) * 200.0f - 100.0f, y = _rand(&seed) * 200.0f - 100.0f;
+      f32 r = _rand(&seed) * 40.0f;
+      u32 ct = Grid__queryRadius(&g, x, y, r, out, 1000);
+      u32 expect = 0;
+      for (u32 i = 0; i < 1000; i++) {
+        f32 dx = g.x[i] - x, dy = g.y[i] - y;
+        if (dx * dx + dy * dy <= r * r) {
+          expect++;
+          ASSERT(_has(out, ct, i));
+        }
+      }
+      ASSERT(expect == ct);  // and no duplicates
+    }
+    u32 ct = Grid__queryAabb(&g, -1000.0f, -1000.0f, 1000.0f, 1000.0f, out, 1000);
+    ASSERT(1000 == ct);  // more cells than buckets: full bucket walk
+    ct = Grid__queryAabb(&g, -1000.0f, -1000.0f, 1000.0f, 1000.0f, out, 10);
+    ASSERT(10 == ct);  // truncated at max
+  }
+
+  // ---
+  // Scenario: View diff reports entered, left, stayed
+  {
+    GridView v;
+    bool ok = GridView__init(&v, _G->arena, 128);
+    ASSERT(ok);
+    GridDiff d;
+    u32 a[] = {1, 2, 3, 100};
+    GridView__diff(&v, a, 4, _G->arena, &d);
+    ASSERT(4 == d.enteredCt && 0 == d.leftCt && 0 == d.stayedCt);
+
+    u32 b[] = {3, 4, 1};
+    GridView__diff(&v, b, 3, _G->arena, &d);
+    ASSERT(1 == d.enteredCt && 4 == d.entered[0]);
+    ASSERT(2 == d.leftCt && _has(d.left, 2, 2) && _has(d.left, 2, 100));
+    ASSERT(2 == d.stayedCt && _has(d.stayed, 2, 1) && _has(d.stayed, 2, 3));
+
+    GridView__diff(&v, NULL, 0, _G->arena, &d);
+    ASSERT(0 == d.enteredCt && 3 == d.leftCt && 0 == v.len);
+  }
+
+  // ---
+  // Scenario: Benchmark interest sets for clients x entities vs brute force
+  {
+    Grid g;
+    Grid__init(&g, _G->arena, ITEM_CT, ITEM_CT / 2, VIEW_R);
+    f32* cx = Arena__pushArray(_G->arena, f32, CLIENT_CT);
+    f32* cy = Arena__pushArray(_G->arena, f32, CLIENT_CT);
+    u32* out = Arena__pushArray(_G->arena, u32, ITEM_CT);
+    u32 seed = 9;
+    for (u32 i = 0; i < ITEM_CT; i++) {
+      Grid__insert(&g, i, _rand(&seed) * WORLD_SZ, _rand(&seed) * WORLD_SZ);
+    }
+    for (u32 c = 0; c < CLIENT_CT; c++) {
+      cx[c] = _rand(&seed) * WORLD_SZ;
+      cy[c] = _rand(&seed) * WORLD_SZ;
+    }
+
+    u64 gridTotal = 0, bruteTotal = 0;
+    u64 start = Time__perf_now();
+    for (u32 c = 0; c < CLIENT_CT; c++) {
+      gridTotal += Grid__queryRadius(&g, cx[c], cy[c], VIEW_R, out, ITEM_CT);
+    }
+    u64 gridNs = Time__perf_now() - start;
+    start = Time__perf_now();
+    for (u32 c = 0; c < CLIENT_CT; c++) {
+      for (u32 i = 0; i < ITEM_CT; i++) {
+        f32 dx = g.x[i] - cx[c], dy = g.y[i] - cy[c];
+        bruteTotal += dx * dx + dy * dy <= VIEW_R * VIEW_R;
+      }
+    }
+    u64 bruteNs = Time__perf_now() - start;
+    ASSERT(gridTotal == bruteTotal);
+    LOG_DEBUGF(
+        "%u clients x %u entities: Grid %6llu us  brute force %6llu us",
+        CLIENT_CT,
+        ITEM_CT,
+        Time__us(gridNs),
+        Time__us(bruteNs));
+  }
+
+  return 0;
+}
\ No newline at end of file
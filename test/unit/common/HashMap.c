@@ -0,0 +1,126 @@
+#define UNIT_TEST
+
+#include "../../../src/unity.h"  // IWYU pragma: keep
+
+GENERIC_HASHMAP(U64Map, u64, u32);
+GENERIC_HASHMAP_FNS(U64Map, u64, u32, Hash__u64, HASHMAP__EQ);
+
+// void* -> u32, same key type List stores
+GENERIC_HASHMAP(PtrMap, void*, u32);
+GENERIC_HASHMAP_FNS(PtrMap, void*, u32, Hash__ptr, HASHMAP__EQ);
+
+#define Hash__cstr(s) Hash__bytes((s), strlen(s))
+#define Cstr__eq(a, b) (0 == strcmp((a), (b)))
+GENERIC_HASHMAP(NameMap, const char*, u32);
+GENERIC_HASHMAP_FNS(NameMap, const char*, u32, Hash__cstr, Cstr__eq);
+
+#define LOOKUPS (1000)
+
+// time LOOKUPS membership tests (half hits) against ct entries, map vs List__has_item
+static void _HashMap__bench(u32 ct) {
+  Arena* a = Arena__reserve(256 * 1024 * 1024, 0);
+  u8* keys = Arena__push(a, ct * 2);  // addresses are the keys; odd half never inserted
+  PtrMap m;
+  PtrMap__init(&m, a, ct);
+  List* list = List__alloc(a);
+  for (u32 i = 0; i < ct; i++) {
+    PtrMap__put(&m, keys + i * 2, i);
+    List__append(a, list, keys + i * 2);
+  }
+
+  u32 hits = 0;
+  u64 start = Time__perf_now();
+  for (u32 i = 0; i < LOOKUPS; i++) {
+    hits += PtrMap__has(&m, keys + (u64)i * 7919 % (ct * 2));
+  }
+  u64 mapNs = Time__perf_now() - start;
+  u32 listHits = 0;
+  start = Time__perf_now();
+  for (u32 i = 0; i < LOOKUPS; i++) {
+    listHits += List__has_item(list, keys + (u64)i * 7919 % (ct * 2));
+  }
+  u64 listNs = Time__perf_now() - start;
+  ASSERT_CONTEXT(hits == listHits, "map %u hits, list %u", hits, listHits);
+  LOG_DEBUGF(
+      "%6u entries, %u lookups: HashMap %6llu us (%llu ns/op)  List %8llu us (%llu ns/op)",
+      ct,
+      LOOKUPS,
+      Time__us(mapNs),
+      mapNs / LOOKUPS,
+      Time__us(listNs),
+      listNs / LOOKUPS);
+  Arena__free(a);
+}
+
+// @describe HashMap
+// @tag common
+int main() {
+  _G->arena = Arena__allocZ(16 * 1024 * 1024);
+
+  // ---
+  // Scenario: Put, get, overwrite, remove
+  {
+    U64Map m;
+    bool ok = U64Map__init(&m, _G->arena, 0);
+    ASSERT(ok && HASHMAP__GROUP == m.cap);
+    U64Map__put(&m, 42, 1);
+    U64Map__put(&m, 7, 2);
+    ASSERT(2 == m.len && 1 == *U64Map__get(&m, 42) && 2 == *U64Map__get(&m, 7));
+    U64Map__put(&m, 42, 3);
+    ASSERT(2 == m.len && 3 == *U64Map__get(&m, 42));
+    ASSERT(NULL == U64Map__get(&m, 8) && !U64Map__has(&m, 8));
+    ASSERT(U64Map__remove(&m, 42) && !U64Map__remove(&m, 42));
+    ASSERT(1 == m.len && !U64Map__has(&m, 42) && U64Map__has(&m, 7));
+  }
+
+  // ---
+  // Scenario: Growth and churn keep every live key reachable
+  {
+    U64Map m;
+    U64Map__init(&m, _G->arena, 0);
+    for (u64 i = 0; i < 20000; i++) {
+      U64Map__put(&m, i, (u32)i);
+      if (i >= 100) {
+        bool removed = U64Map__remove(&m, i - 100);  // sliding window: tombstones + reuse
+        ASSERT(removed);
+      }
+    }
+    ASSERT(100 == m.len && m.cap <= 1024);  // rehash reclaims tombstones instead of doubling
+    for (u64 i = 0; i < 20000; i++) {
+      ASSERT_CONTEXT((i >= 19900) == U64Map__has(&m, i), "key %llu", i);
+    }
+    u32 seen = 0;
+    U64Map__Entry* e;
+    for (u32 it = 0; NULL != (e = U64Map__each(&m, &it));) {
+      ASSERT(e->key == e->val);
+      seen++;
+    }
+    ASSERT(100 == seen);
+    U64Map__clear(&m);
+    ASSERT(0 == m.len && !U64Map__has(&m, 19999));
+  }
+
+  // ---
+  // Scenario: String keys with the built-in byte hash
+  {
+    NameMap m;
+    NameMap__init(&m, _G->arena, 4);
+    char buf[16];
+    snprintf(buf, sizeof(buf), "%s", "player");
+    NameMap__put(&m, "player", 1);
+    NameMap__put(&m, "enemy", 2);
+    ASSERT(1 == *NameMap__get(&m, buf));  // equal contents, different pointer
+    ASSERT(!NameMap__has(&m, "players"));
+    ASSERT(Hash__bytes("abc", 3) != Hash__bytes("abd", 3));
+    ASSERT(Hash__bytes("", 0) == Hash__bytes("x", 0));
+  }
+
+  // ---
+  // Scenario: Benchmark vs List__has_item
+  {
+    _HashMap__bench(1000);
+    _HashMap__bench(100000);
+  }
+
+  return 0;
+}
\ No newline at end of file
@@ -0,0 +1,135 @@
+#define UNIT_TEST
+
+#include "../../../src/unity.h"  // IWYU pragma: keep
+
+typedef struct {
+  u32 at;
+  u32 id;
+} Timer;
+
+#define Timer__less(a, b) ((a).at < (b).at)
+
+GENERIC_HEAP(Timers, Timer);
+GENERIC_HEAP_FNS(Timers, Timer, Timer__less);
+
+#define BENCH_CT (10000)
+
+// List__sorter_t over Timer*
+static s8 _Timer__cmp(const void* a, const void* b) {
+  u32 x = ((const Timer*)a)->at, y = ((const Timer*)b)->at;
+  return x < y ? -1 : x > y ? 1 : 0;
+}
+
+// @describe Heap
+// @tag common
+int main() {
+  _G->arena = Arena__allocZ(4 * 1024 * 1024);
+
+  // ---
+  // Scenario: Pops come out smallest first, across growth
+  {
+    Timers h;
+    bool ok = Timers__init(&h, _G->arena, 2);
+    ASSERT(ok);
+    u32 seed = 1;
+    for (u32 i = 0; i < 100; i++) {
+      seed = seed * 1664525u + 1013904223u;
+      Timers__push(&h, (Timer){.at = seed >> 20, .id = i});
+    }
+    ASSERT(100 == h.len && h.cap >= 100);
+    Timer t, prev = {0};
+    u32 ct = 0;
+    while (Timers__pop(&h, &t)) {
+      ASSERT(t.at >= prev.at);
+      prev = t;
+      ct++;
+    }
+    ASSERT(100 == ct && NULL == Timers__peek(&h));
+  }
+
+  // ---
+  // Scenario: Decrease-key, increase-key and remove by handle
+  {
+    Timers h;
+    Timers__init(&h, _G->arena, 8);
+    u32 a = Timers__push(&h, (Timer){.at = 10, .id = 1});
+    u32 b = Timers__push(&h, (Timer){.at = 20, .id = 2});
+    u32 c = Timers__push(&h, (Timer){.at = 30, .id = 3});
+    ASSERT(1 == Timers__peek(&h)->id);
+
+    ASSERT(Timers__update(&h, c, (Timer){.at = 5, .id = 3}));  // decrease-key
+    ASSERT(3 == Timers__peek(&h)->id);
+    ASSERT(Timers__update(&h, c, (Timer){.at = 25, .id = 3}));  // increase-key
+    ASSERT(1 == Timers__peek(&h)->id && 25 == Timers__get(&h, c)->at);
+
+    ASSERT(Timers__remove(&h, a));
+    ASSERT(NULL == Timers__get(&h, a) && !Timers__remove(&h, a));
+    ASSERT(!Timers__update(&h, a, (Timer){0}));
+    ASSERT(2 == Timers__peek(&h)->id && 2 == h.len);
+
+    u32 d = Timers__push(&h, (Timer){.at = 1, .id = 4});
+    ASSERT(d == a && 4 == Timers__peek(&h)->id);  // freed handle is reused
+    ASSERT(20 == Timers__get(&h, b)->at && NULL == Timers__get(&h, 7));
+  }
+
+  // ---
+  // Scenario: Random updates + removes keep heap order
+  {
+    Timers h;
+    Timers__init(&h, _G->arena, 64);
+    u32 handles[500];
+    u32 seed = 7;
+    for (u32 i = 0; i < 500; i++) {
+      seed = seed * 1664525u + 1013904223u;
+      handles[i] = Timers__push(&h, (Timer){.at = seed >> 16, .id = i});
+    }
+    for (u32 i = 0; i < 500; i += 3) {
+      seed = seed * 1664525u + 1013904223u;
+      Timers__update(&h, handles[i], (Timer){.at = seed >> 16, .id = i});
+      Timers__remove(&h, handles[i + 1]);
+    }
+    for (u32 i = 1; i < h.len; i++) {
+      ASSERT(h.nodes[(i - 1) / HEAP__D].item.at <= h.nodes[i].item.at);
+      ASSERT(i == h.pos[h.nodes[i].handle]);
+    }
+  }
+
+  // ---
+  // Scenario: Benchmark push + pop all vs List__insort + List__shift
+  {
+    Timers h;
+    Timers__init(&h, _G->arena, BENCH_CT);
+    Timer* timers = Arena__pushArray(_G->arena, Timer, BENCH_CT);
+    List* list = List__alloc(_G->arena);
+    u32 seed = 42;
+    for (u32 i = 0; i < BENCH_CT; i++) {
+      seed = seed * 1664525u + 1013904223u;
+      timers[i] = (Timer){.at = seed >> 8, .id = i};
+    }
+
+    u64 start = Time__perf_now();
+    for (u32 i = 0; i < BENCH_CT; i++) {
+      Timers__push(&h, timers[i]);
+    }
+    Timer t;
+    while (Timers__pop(&h, &t)) {
+    }
+    u64 heapNs = Time__perf_now() - start;
+
+    start = Time__perf_now();
+    for (u32 i = 0; i < BENCH_CT; i++) {
+      List__insort(_G->arena, list, &timers[i], _Timer__cmp);
+    }
+    while (NULL != List__shift(list)) {
+    }
+    u64 listNs = Time__perf_now() - start;
+    ASSERT(0 == h.len && 0 == list->len);
+    LOG_DEBUGF(
+        "push + pop %u items: Heap %6llu us  List %6llu us",
+        BENCH_CT,
+        Time__us(heapNs),
+        Time__us(listNs));
+  }
+
+  return 0;
+}
\ No newline at end of file
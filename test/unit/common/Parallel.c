@@ -0,0 +1,102 @@
+#define UNIT_TEST
+
+#include "../../../src/unity.h"  // IWYU pragma: keep
+
+#define N (100000)
+
+static u32 _values[N];
+static u32 _hits[N];
+
+// count every index visited
+static void _Test__mark(ParallelTask* t) {
+  for (u32 i = t->begin; i < t->end; i++) {
+    Atomic__add(&_hits[i], 1);
+  }
+}
+
+// per-worker partial sum
+static void _Test__sum(ParallelTask* t) {
+  u64* acc = (u64*)t->acc;
+  u32* v = (u32*)t->range.ptr;
+  for (u32 i = 0; i < t->range.ct; i++) {
+    *acc += v[i];
+  }
+}
+
+static void _Test__add(void* acc, const void* partial, void* userdata) {
+  *(u64*)acc += *(const u64*)partial;
+}
+
+// @describe Parallel
+// @tag common
+int main() {
+  _G->arena = Arena__allocZ(64 * 1024);
+  bool ok = Parallel__init(4);
+  ASSERT(ok);
+  LOG_DEBUGF("workers: %u", Parallel__workers());
+  ASSERT(0 == sizeof(ParallelWorker) % CACHELINE_SZ);
+  ASSERT(0 == (uintptr_t)&parallel.workers[0] % CACHELINE_SZ);  // no false sharing of acc
+
+  u64 expect = 0;
+  for (u32 i = 0; i < N; i++) {
+    _values[i] = i * 7 + 1;
+    expect += _values[i];
+  }
+
+  // ---
+  // Scenario: Parallel__for visits every index exactly once
+  {
+    for (u32 grain = 1; grain <= 4096; grain *= 64) {
+      memset(_hits, 0, sizeof(_hits));
+      Parallel__for(ARANGE2(_values), grain, _Test__mark, NULL);
+      u32 bad = 0;
+      for (u32 i = 0; i < N; i++) {
+        bad += 1 != _hits[i];
+      }
+      ASSERT(0 == bad);
+    }
+  }
+
+  // ---
+  // Scenario: Reduce with a non-zero initial value counts it once
+  {
+    const u64 zero = 0;
+    u64 sum = 1000;
+    Parallel__reduce(ARANGE2(_values), 256, _Test__sum, _Test__add, &zero, &sum, sizeof(u64), NULL);
+    ASSERT(expect + 1000 == sum);
+  }
+
+  // ---
+  // Scenario: Range smaller than one chunk runs inline
+  {
+    const u64 zero = 0;
+    u64 sum = 5;
+    ARange2 small = {.ptr = _values, .ct = 10, .stride = sizeof(u32)};
+    Parallel__reduce(small, 0, _Test__sum, _Test__add, &zero, &sum, sizeof(u64), NULL);
+    u64 want = 5;
+    for (u32 i = 0; i < 10; i++) {
+      want += _values[i];
+    }
+    ASSERT(want == sum);
+
+    memset(_hits, 0, sizeof(_hits));
+    Parallel__for(small, 0, _Test__mark, NULL);
+    ASSERT(1 == _hits[0] && 1 == _hits[9] && 0 == _hits[10]);
+  }
+
+  // ---
+  // Scenario: Empty range is a no-op
+  {
+    const u64 zero = 0;
+    u64 sum = 42;
+    ARange2 empty = {.ptr = _values, .ct = 0, .stride = sizeof(u32)};
+    Parallel__reduce(empty, 0, _Test__sum, _Test__add, &zero, &sum, sizeof(u64), NULL);
+    ASSERT(42 == sum);
+    memset(_hits, 0, sizeof(_hits));
+    Parallel__for(empty, 0, _Test__mark, NULL);
+    ASSERT(0 == _hits[0]);
+  }
+
+  Parallel__shutdown();
+  return 0;
+}
\ No newline at end of file
@@ -0,0 +1,131 @@
+#define UNIT_TEST
+
+#include "../../../src/unity.h"  // IWYU pragma: keep
+
+typedef struct {
+  u64 id;
+  u8 payload[40];
+} Msg;
+
+GENERIC_POOL(MsgPool, Msg);
+GENERIC_POOL_FNS(MsgPool, Msg);
+
+#define WORKERS (4)
+#define ITERS (100000)
+
+static MsgPool _shared;
+
+// alloc/free in bursts through a thread-local cache; slots stay owned while held
+THREAD_FN_RET _Pool__worker(THREAD_FN_PARAM1 userdata) {
+  static __thread PoolCache cache;
+  Msg* held[16];
+  u64 id = (u64)(uintptr_t)userdata;
+  for (u32 i = 0; i < ITERS; i += ARRAYSIZE(held)) {
+    for (u32 j = 0; j < ARRAYSIZE(held); j++) {
+      held[j] = MsgPool__allocCached(&_shared, &cache);
+      ASSERT(NULL != held[j]);
+      held[j]->id = id;
+    }
+    for (u32 j = 0; j < ARRAYSIZE(held); j++) {
+      ASSERT_CONTEXT(id == held[j]->id, "slot handed to two threads");
+      MsgPool__freeCached(&_shared, &cache, held[j]);
+    }
+  }
+  Pool__flush(&_shared.pool, &cache);
+  return THREAD_FN_RET_VAL;
+}
+
+// @describe Pool
+// @tag common
+int main() {
+  _G->arena = Arena__allocZ(4 * 1024 * 1024);
+
+  // ---
+  // Scenario: Freed slots are reused before new pages are carved
+  {
+    MsgPool p;
+    MsgPool__init(&p, _G->arena, 4);
+    Msg* a = MsgPool__alloc(&p);
+    Msg* b = MsgPool__alloc(&p);
+    ASSERT(NULL != a && NULL != b && a != b);
+    ASSERT(0 == (uintptr_t)a % sizeof(void*) && 0 == (uintptr_t)b % sizeof(void*));
+    ASSERT(4 == p.pool.carved && 2 == p.pool.live);
+    MsgPool__free(&p, a);
+    Msg* c = MsgPool__alloc(&p);
+    ASSERT(a == c);  // LIFO: most recently freed (still warm in cache) comes back first
+    for (u32 i = 0; i < 3; i++) {
+      MsgPool__alloc(&p);
+    }
+    ASSERT(8 == p.pool.carved && 5 == p.pool.live);
+  }
+
+  // ---
+  // Scenario: Pooled List used as a queue keeps memory bounded under churn
+  {
+    Pool nodes;
+    Pool__init(&nodes, _G->arena, sizeof(List__Node), 0);
+    List* q = List__allocPool(_G->arena, &nodes);
+    u8* before = _G->arena->pos;
+    for (u32 i = 0; i < 100000; i++) {
+      List__append(NULL, q, (void*)(uintptr_t)(i + 1));
+      if (q->len > 8) {
+        void* v = List__shift(q);
+        ASSERT((uintptr_t)v == i - 7);
+      }
+    }
+    ASSERT(8 == nodes.live && POOL__PAGE_SLOTS == nodes.carved);
+    ASSERT((u64)(_G->arena->pos - before) < 2 * POOL__PAGE_SLOTS * sizeof(List__Node));
+
+    void* v = (void*)(uintptr_t)99999;
+    ASSERT(List__remove_item(q, v));
+    ASSERT(!List__remove_item(q, v));
+    ASSERT((void*)(uintptr_t)100000 == List__pop(q));
+    ASSERT(6 == q->len && 6 == nodes.live);
+    List__reset(q);
+    ASSERT(0 == q->len && NULL == q->tail && 0 == nodes.live);
+  }
+
+  // ---
+  // Scenario: List insert fails cleanly when its pool can't get memory
+  {
+    Arena* a = Arena__reserve(ARENA__COMMIT_SZ, ARENA__KEEP_ALL);
+    ASSERT(NULL != a);
+    a->flags &= ~ARENA__VM;  // simulate the OS refusing to commit: pushes return NULL
+    Pool nodes;
+    Pool__init(&nodes, a, sizeof(List__Node), 0);
+    List q;
+    List__init(&q, &nodes);
+    int x = 0;
+    ASSERT(!List__append(NULL, &q, &x));
+    ASSERT(!List__prepend(NULL, &q, &x));
+    ASSERT(!List__insort(NULL, &q, &x, NULL));
+    ASSERT(0 == q.len && NULL == q.head && NULL == q.tail);
+    a->flags |= ARENA__VM;
+    Arena__free(a);
+  }
+
+  // ---
+  // Scenario: Shared pool with per-thread caches
+  {
+    MsgPool__init(&_shared, _G->arena, 0);
+    Thread t[WORKERS];
+    u64 start = Time__perf_now();
+    for (u32 i = 0; i < WORKERS; i++) {
+      bool created = Thread__create(&t[i], _Pool__worker, (void*)(uintptr_t)(i + 1));
+      ASSERT_CONTEXT(created, "Failed to create worker %u", i);
+    }
+    Thread__join(t, WORKERS);
+    Thread__destroy(t, WORKERS);
+    u64 ns = Time__perf_now() - start;
+    ASSERT_CONTEXT(0 == _shared.pool.live, "%llu slots leaked", _shared.pool.live);
+    LOG_DEBUGF(
+        "Pool %u threads x %u alloc+free: %6llu us (%llu ns/op), %llu slots carved",
+        WORKERS,
+        ITERS,
+        Time__us(ns),
+        ns / (WORKERS * ITERS),
+        _shared.pool.carved);
+  }
+
+  return 0;
+}
\ No newline at end of file
@@ -0,0 +1,146 @@
+#define UNIT_TEST
+
+#include "../../../src/unity.h"  // IWYU pragma: keep
+
+GENERIC_SPSC(U32Spsc, u32, 4);
+GENERIC_SPSC_FNS(U32Spsc, u32, 4);
+GENERIC_MPSC(U32Mpsc, u32, 8);
+GENERIC_MPSC_FNS(U32Mpsc, u32, 8);
+
+#define PRODUCERS (4)
+#define ITEMS_PER_PRODUCER (100000)
+
+static U32Spsc* _spsc;
+static U32Mpsc* _mpsc;
+
+// push 0..n-1 in order (single producer)
+THREAD_FN_RET _Queue__spscProducer(THREAD_FN_PARAM1 userdata) {
+  u32 i = 0;
+  while (i < ITEMS_PER_PRODUCER) {
+    if (U32Spsc__push(_spsc, i)) {
+      i++;
+    } else {
+      Thread__yield();  // full; let consumer drain
+    }
+  }
+  return THREAD_FN_RET_VAL;
+}
+
+// push (producer id << 24 | seq), alternating single + batch pushes
+THREAD_FN_RET _Queue__mpscProducer(THREAD_FN_PARAM1 userdata) {
+  u32 id = (u32)(uintptr_t)userdata;
+  u32 i = 0;
+  while (i < ITEMS_PER_PRODUCER) {
+    if (0 == (i & 1)) {
+      if (U32Mpsc__push(_mpsc, (id << 24) | i)) {
+        i++;
+      } else {
+        Thread__yield();
+      }
+    } else {
+      u32 batch[3] = {(id << 24) | i, (id << 24) | (i + 1), (id << 24) | (i + 2)};
+      u32 n = U32Mpsc__push_n(_mpsc, batch, Math__min(3, ITEMS_PER_PRODUCER - i));
+      if (0 == n) {
+        Thread__yield();
+      }
+      i += n;
+    }
+  }
+  return THREAD_FN_RET_VAL;
+}
+
+// @describe Queue
+// @tag common
+int main() {
+  _G->arena = Arena__allocZ(1024 * 1024);
+
+  // ---
+  // Scenario: Spsc fill, drain, and wrap-around
+  {
+    U32Spsc* q = Arena__push(_G->arena, sizeof(U32Spsc));
+    U32Spsc__init(q);
+    u32 v = 0;
+    bool empty = !U32Spsc__pop(q, &v);
+    ASSERT(empty);
+    u32 pushed = 0;
+    for (u32 i = 0; i < 16; i++) {
+      pushed += U32Spsc__push(q, i);
+    }
+    ASSERT(16 == pushed);
+    bool full = !U32Spsc__push(q, 99);
+    ASSERT(full);  // no wasted slot
+    ASSERT(16 == U32Spsc__len(q));
+
+    u32 out[16];
+    u32 n = U32Spsc__pop_n(q, out, 10);
+    ASSERT(10 == n);
+    ASSERT(0 == out[0] && 9 == out[9]);
+
+    u32 in[12] = {100, 101, 102, 103, 104, 105, 106, 107, 108, 109, 110, 111};
+    n = U32Spsc__push_n(q, in, 12);
+    ASSERT(10 == n);  // wraps; only 10 free
+    n = U32Spsc__pop_n(q, out, 16);
+    ASSERT(16 == n);
+    ASSERT(10 == out[0] && 15 == out[5] && 100 == out[6] && 109 == out[15]);
+    ASSERT(0 == U32Spsc__len(q));
+  }
+
+  // ---
+  // Scenario: Spsc across threads preserves order
+  {
+    _spsc = Arena__push(_G->arena, sizeof(U32Spsc));
+    U32Spsc__init(_spsc);
+    Thread t[1];
+    bool created = Thread__create(&t[0], _Queue__spscProducer, NULL);
+    ASSERT_CONTEXT(created, "Failed to create producer thread");
+
+    u32 expect = 0;
+    while (expect < ITEMS_PER_PRODUCER) {
+      u32 out[8];
+      u32 n = U32Spsc__pop_n(_spsc, out, 8);
+      if (0 == n) {
+        Thread__yield();  // empty; let producer fill
+      }
+      for (u32 i = 0; i < n; i++) {
+        ASSERT_CONTEXT(expect == out[i], "expected %u, got %u", expect, out[i]);
+        expect++;
+      }
+    }
+    Thread__join(t, 1);
+    Thread__destroy(t, 1);
+  }
+
+  // ---
+  // Scenario: Mpsc with concurrent producers preserves per-producer order
+  {
+    _mpsc = Arena__push(_G->arena, sizeof(U32Mpsc));
+    U32Mpsc__init(_mpsc);
+    Thread t[PRODUCERS];
+    for (u32 i = 0; i < PRODUCERS; i++) {
+      bool created = Thread__create(&t[i], _Queue__mpscProducer, (void*)(uintptr_t)i);
+      ASSERT_CONTEXT(created, "Failed to create producer thread %u", i);
+    }
+
+    u32 next[PRODUCERS] = {0};
+    u32 total = 0;
+    while (total < PRODUCERS * ITEMS_PER_PRODUCER) {
+      u32 out[16];
+      u32 n = U32Mpsc__pop_n(_mpsc, out, 16);
+      if (0 == n) {
+        Thread__yield();
+      }
+      for (u32 i = 0; i < n; i++) {
+        u32 id = out[i] >> 24, seq = out[i] & 0xffffff;
+        ASSERT_CONTEXT(id < PRODUCERS, "bad producer id %u", id);
+        ASSERT_CONTEXT(next[id] == seq, "producer %u expected %u, got %u", id, next[id], seq);
+        next[id]++;
+      }
+      total += n;
+    }
+    Thread__join(t, PRODUCERS);
+    Thread__destroy(t, PRODUCERS);
+    ASSERT(0 == U32Mpsc__len(_mpsc));
+  }
+
+  return 0;
+}
\ No newline at end of file
@@ -0,0 +1,213 @@
+#define UNIT_TEST
+
+#include "../../../src/unity.h"  // IWYU pragma: keep
+
+#define LOG_PATH "/tmp/test_replay.tklg"
+#define MANY_IDS (5000)  // past the old 4096 id cap
+
+// what the replayed engine saw
+static u64 _ticks[8];
+static u32 _tickCt;
+static u32 _recvIds[MANY_IDS + 8];
+static u8 _recvBytes[256];
+static u32 _recvCt, _recvLen;
+
+static void _Test__tick(void) {
+  if (_tickCt < ARRAYSIZE(_ticks)) {
+    _ticks[_tickCt] = _G->tick;
+  }
+  _tickCt++;
+}
+
+static void _Test__recv(Socket* sock, u8* buf, u32 len) {
+  if (_recvCt < ARRAYSIZE(_recvIds)) {
+    _recvIds[_recvCt] = sock->id;
+  }
+  _recvCt++;
+  if (_recvLen + len <= sizeof(_recvBytes)) {
+    memcpy(_recvBytes + _recvLen, buf, len);
+    _recvLen += len;
+  }
+}
+
+static u32 _closedRecvs;
+
+// _Test__recv that also counts deliveries to a socket already marked closed
+static void _Test__recvState(Socket* sock, u8* buf, u32 len) {
+  _closedRecvs += SOCKET_CLOSED == sock->state;
+  _Test__recv(sock, buf, len);
+}
+
+static void _Test__reset(void) {
+  _tickCt = _recvCt = _recvLen = 0;
+}
+
+// fresh log with one tick per entry of ids, each delivering "msg" from that id
+static void _Test__record(const u32* ids, u32 ct) {
+  remove(LOG_PATH);
+  Replay r = {0};
+  bool opened = Replay__open(&r, LOG_PATH);
+  ASSERT(opened);
+  for (u32 i = 0; i < ct; i++) {
+    _G->tick = 100 + i;
+    _G->now = 5000 + i;
+    Replay__beginTick(&r);
+    Socket sock = {.id = ids[i]};
+    Replay__recv(&r, &sock, (const u8*)"msg", 3);
+  }
+  Replay__close(&r);
+}
+
+// @describe Replay
+// @tag common
+int main() {
+  _G->arena = Arena__allocZ(1024 * 1024);
+  _G->onsockrecv = _Test__recv;
+
+  // ---
+  // Scenario: Varints round-trip at every width; truncated input is rejected
+  {
+    u64 vals[] = {0, 1, 127, 128, 300, 16383, 16384, UINT32_MAX, 1ull << 56, UINT64_MAX};
+    for (u32 i = 0; i < ARRAYSIZE(vals); i++) {
+      u8 buf[10];
+      u32 n = _Replay__putVarint(buf, vals[i]);
+      ASSERT(n >= 1 && n <= 10);
+      const u8* p = buf;
+      u64 v = 0;
+      bool ok = _Replay__getVarint(&p, buf + n, &v);
+      ASSERT(ok && vals[i] == v && p == buf + n);
+      p = buf;
+      ok = _Replay__getVarint(&p, buf + n - 1, &v);
+      ASSERT(!ok);
+    }
+  }
+
+  // ---
+  // Scenario: Replay delivers the recorded ticks, ids and bytes, then closes
+  {
+    remove(LOG_PATH);
+    Replay r = {0};
+    Replay__open(&r, LOG_PATH);
+    Socket a = {.id = 7}, b = {.id = 9};
+    _G->tick = 1;
+    _G->now = 1000;
+    _G->seed = 42;
+    Replay__beginTick(&r);
+    Replay__recv(&r, &a, (const u8*)"hello", 5);
+    _G->tick = 2;
+    Replay__beginTick(&r);
+    Replay__recv(&r, &b, (const u8*)"world", 5);
+    Replay__closed(&r, &a);
+    Replay__close(&r);
+
+    _G->tick = _G->now = _G->seed = 0;
+    _Test__reset();
+    ReplayStats stats;
+    bool ok = Replay__run(LOG_PATH, _Test__tick, &stats);
+    ASSERT(ok && 2 == stats.ticks && 2 == stats.msgs && 10 == stats.msgBytes);
+    ASSERT(2 == _tickCt && 1 == _ticks[0] && 2 == _ticks[1]);
+    ASSERT(1000 == _G->now && 42 == _G->seed);
+    ASSERT(2 == _recvCt && 7 == _recvIds[0] && 9 == _recvIds[1]);
+    ASSERT(10 == _recvLen && 0 == memcmp("helloworld", _recvBytes, 10));
+    Replay__printf(&stats);
+  }
+
+  // ---
+  // Scenario: A torn tail stops the replay cleanly; earlier ticks still run
+  {
+    u32 ids[] = {1, 2, 3};
+    _Test__record(ids, 3);
+    FILE* f = fopen(LOG_PATH, "rb+");
+    fseek(f, 0, SEEK_END);
+    long sz = ftell(f);
+    fclose(f);
+    bool cut = 0 == truncate(LOG_PATH, sz - 2);  // mid-way through the last message bytes
+    ASSERT(cut);
+
+    _Test__reset();
+    ReplayStats stats;
+    bool ok = Replay__run(LOG_PATH, _Test__tick, &stats);
+    ASSERT(!ok);
+    ASSERT(3 == _tickCt && 2 == _recvCt);  // last tick runs without its torn message
+  }
+
+  // ---
+  // Scenario: More connection ids than the initial table; none are dropped
+  {
+    u32* ids = Arena__pushArray(_G->arena, u32, MANY_IDS);
+    for (u32 i = 0; i < MANY_IDS; i++) {
+      ids[i] = i + 1;
+    }
+    _Test__record(ids, MANY_IDS);
+    _Test__reset();
+    ReplayStats stats;
+    bool ok = Replay__run(LOG_PATH, _Test__tick, &stats);
+    ASSERT(ok && MANY_IDS == _tickCt && MANY_IDS == _recvCt);
+    ASSERT(4097 == _recvIds[4096] && MANY_IDS == _recvIds[MANY_IDS - 1]);
+
+    // sparse ids cost one map entry each, not a table sized to the largest id
+    u32 sparse[] = {UINT32_MAX, 3, UINT32_MAX - 1};
+    _Test__record(sparse, ARRAYSIZE(sparse));
+    _Test__reset();
+    ok = Replay__run(LOG_PATH, _Test__tick, &stats);
+    ASSERT(ok && 3 == _recvCt && UINT32_MAX == _recvIds[0] && UINT32_MAX - 1 == _recvIds[2]);
+
+    // an id that can't be a Socket.id fails loudly instead of being skipped
+    remove(LOG_PATH);
+    Replay r = {0};
+    Replay__open(&r, LOG_PATH);
+    Replay__beginTick(&r);
+    u8 rec[16];
+    u32 n = 0;
+    rec[n++] = REPLAY_CLOSE;
+    n += _Replay__putVarint(rec + n, 1ull << 40);
+    _Replay__write(&r, rec, n);
+    Replay__close(&r);
+    ok = Replay__run(LOG_PATH, _Test__tick, &stats);
+    ASSERT(!ok);
+  }
+
+  // ---
+  // Scenario: Two runs appended to one log replay as separate sessions
+  {
+    remove(LOG_PATH);
+    static const char* msgs[] = {"first", "again"};
+    for (u32 run = 0; run < 2; run++) {
+      Replay r = {0};  // a new process: ids + ticks restart
+      bool opened = Replay__open(&r, LOG_PATH);
+      ASSERT(opened);
+      Socket sock = {.id = 1};
+      _G->tick = 1;
+      Replay__beginTick(&r);
+      Replay__recv(&r, &sock, (const u8*)msgs[run], 5);
+      if (0 == run) {
+        Replay__closed(&r, &sock);  // only the first run's connection 1 hangs up
+      }
+      Replay__close(&r);
+    }
+
+    _Test__reset();
+    _G->onsockrecv = _Test__recvState;
+    ReplayStats stats;
+    bool ok = Replay__run(LOG_PATH, _Test__tick, &stats);
+    _G->onsockrecv = _Test__recv;
+    ASSERT(ok && 2 == stats.sessions && 2 == stats.ticks && 2 == stats.msgs);
+    ASSERT(2 == _tickCt && 1 == _ticks[0] && 1 == _ticks[1]);
+    ASSERT(2 == _recvCt && 1 == _recvIds[0] && 1 == _recvIds[1]);
+    ASSERT(0 == memcmp("firstagain", _recvBytes, 10));
+    ASSERT(0 == _closedRecvs);  // second session's id 1 is a fresh, connected socket
+    ASSERT(1 <= stats.maxSession && stats.maxSession <= 2);
+
+    // a log of another format is never appended to
+    FILE* f = fopen(LOG_PATH, "wb");
+    u32 v1[2] = {REPLAY__MAGIC, 1};
+    fwrite(v1, sizeof(v1), 1, f);
+    fclose(f);
+    Replay r = {0};
+    ok = Replay__open(&r, LOG_PATH);
+    ASSERT(!ok && NULL == r.file);
+  }
+
+  remove(LOG_PATH);
+  return 0;
+}
\ No newline at end of file
@@ -0,0 +1,106 @@
+#define UNIT_TEST
+
+#include "../../../src/unity.h"  // IWYU pragma: keep
+
+GENERIC_RING(U32Ring, u32, 3);  // 8 slots
+GENERIC_RING_FNS(U32Ring, u32, 3);
+
+GENERIC_RING(BenchRing, u32, 10);
+GENERIC_RING_FNS(BenchRing, u32, 10);
+
+#define BENCH_CT (1000000)
+
+// @describe Ring
+// @tag common
+int main() {
+  _G->arena = Arena__allocZ(1024 * 1024);
+
+  // ---
+  // Scenario: Uses every slot; push fails when full, pop when empty
+  {
+    U32Ring r;
+    U32Ring__init(&r);
+    for (u32 i = 0; i < 8; i++) {
+      bool ok = U32Ring__push(&r, i);
+      ASSERT(ok);
+    }
+    ASSERT(8 == U32Ring__len(&r) && !U32Ring__push(&r, 8));
+    ASSERT(0 == *U32Ring__at(&r, 0) && 7 == *U32Ring__at(&r, 7));
+    u32 v;
+    for (u32 i = 0; i < 8; i++) {
+      bool ok = U32Ring__pop(&r, &v);
+      ASSERT(ok && i == v);
+    }
+    ASSERT(0 == U32Ring__len(&r) && !U32Ring__pop(&r, &v));
+  }
+
+  // ---
+  // Scenario: pushOver keeps the newest items
+  {
+    U32Ring r;
+    U32Ring__init(&r);
+    for (u32 i = 0; i < 20; i++) {
+      U32Ring__pushOver(&r, i);
+    }
+    ASSERT(8 == U32Ring__len(&r) && 12 == *U32Ring__at(&r, 0) && 19 == *U32Ring__at(&r, 7));
+  }
+
+  // ---
+  // Scenario: Bulk push/pop split across the wrap, and across u32 counter overflow
+  {
+    U32Ring r;
+    U32Ring__init(&r);
+    r.head = r.tail = UINT32_MAX - 2;  // index 5; counters wrap mid-test
+    u32 src[10] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9}, dst[10] = {0};
+    u32 ct = U32Ring__push_n(&r, src, 10);
+    ASSERT(8 == ct && 8 == U32Ring__len(&r));  // truncated to free space
+    ct = U32Ring__pop_n(&r, dst, 5);
+    ASSERT(5 == ct && 4 == dst[4]);
+    ct = U32Ring__push_n(&r, src + 8, 2);
+    ASSERT(2 == ct && 5 == U32Ring__len(&r));
+    ct = U32Ring__pop_n(&r, dst, 10);
+    ASSERT(5 == ct && 5 == dst[0] && 7 == dst[2] && 8 == dst[3] && 9 == dst[4]);
+    ASSERT(r.head == r.tail && r.head < 8);
+  }
+
+  // ---
+  // Scenario: Benchmark push + pop vs RingBuf (% cap per access)
+  {
+    BenchRing* r = Arena__pushStruct(_G->arena, BenchRing);
+    BenchRing__init(r);
+    u32 cap = 1u << 10;
+    u32* buf = Arena__pushArray(_G->arena, u32, cap);
+    RingBuf rb = {0};
+    u64 sum = 0, sum2 = 0;
+
+    u64 start = Time__perf_now();
+    for (u32 i = 0; i < BENCH_CT; i++) {
+      u32 v;
+      BenchRing__push(r, i);
+      if (BenchRing__len(r) > cap / 2) {
+        BenchRing__pop(r, &v);
+        sum += v;
+      }
+    }
+    u64 ringNs = Time__perf_now() - start;
+
+    start = Time__perf_now();
+    for (u32 i = 0; i < BENCH_CT; i++) {
+      buf[rb.head] = i;
+      Ring__push(&rb, (u16)cap);
+      if ((u16)(rb.head - rb.tail) % cap > cap / 2) {
+        sum2 += buf[rb.tail];
+        Ring__pop(&rb, (u16)cap);
+      }
+    }
+    u64 rbNs = Time__perf_now() - start;
+    ASSERT(sum == sum2);
+    LOG_DEBUGF(
+        "push + pop %u items: GENERIC_RING %6llu us  RingBuf %6llu us",
+        BENCH_CT,
+        Time__us(ringNs),
+        Time__us(rbNs));
+  }
+
+  return 0;
+}
\ No newline at end of file
@@ -0,0 +1,94 @@
+#define UNIT_TEST
+
+#include "../../../src/unity.h"  // IWYU pragma: keep
+
+typedef struct {
+  u32 id;
+  f32 x, y;
+} Obj;
+
+GENERIC_SLOTMAP(Objs, Obj);
+GENERIC_SLOTMAP_FNS(Objs, Obj);
+
+#define BENCH_CT (10000)
+
+// @describe SlotMap
+// @tag common
+int main() {
+  _G->arena = Arena__allocZ(4 * 1024 * 1024);
+
+  // ---
+  // Scenario: Insert, lookup, remove keeps dense storage packed
+  {
+    Objs m;
+    bool ok = Objs__init(&m, _G->arena, 4);
+    ASSERT(ok);
+    SlotHandle a = Objs__insert(&m, (Obj){.id = 1});
+    SlotHandle b = Objs__insert(&m, (Obj){.id = 2});
+    SlotHandle c = Objs__insert(&m, (Obj){.id = 3});
+    ASSERT(3 == m.len && 2 == Objs__get(&m, b)->id);
+
+    ASSERT(Objs__remove(&m, a));
+    ASSERT(2 == m.len && 3 == m.dense[0].id && 2 == m.dense[1].id);  // last moved into hole
+    ASSERT(NULL == Objs__get(&m, a) && !Objs__remove(&m, a));
+    ASSERT(3 == Objs__get(&m, c)->id && 2 == Objs__get(&m, b)->id);
+    ASSERT(c.idx == Objs__handleAt(&m, 0).idx && c.gen == Objs__handleAt(&m, 0).gen);
+
+    SlotHandle null = {0};
+    ASSERT(!Objs__has(&m, null));
+  }
+
+  // ---
+  // Scenario: Reused slots get a new generation; stale handles stay dead
+  {
+    Objs m;
+    Objs__init(&m, _G->arena, 2);
+    SlotHandle a = Objs__insert(&m, (Obj){.id = 1});
+    Objs__insert(&m, (Obj){.id = 2});
+    SlotHandle full = Objs__insert(&m, (Obj){.id = 3});
+    ASSERT(0 == full.gen && !Objs__has(&m, full));
+
+    Objs__remove(&m, a);
+    SlotHandle a2 = Objs__insert(&m, (Obj){.id = 4});
+    ASSERT(a2.idx == a.idx && a2.gen != a.gen);
+    ASSERT(NULL == Objs__get(&m, a) && 4 == Objs__get(&m, a2)->id);
+
+    Objs__clear(&m);
+    ASSERT(0 == m.len && !Objs__has(&m, a2));
+  }
+
+  // ---
+  // Scenario: Benchmark remove by handle vs List__remove_item
+  {
+    Objs m;
+    Objs__init(&m, _G->arena, BENCH_CT);
+    SlotHandle* handles = Arena__pushArray(_G->arena, SlotHandle, BENCH_CT);
+    Obj* objs = Arena__pushArray(_G->arena, Obj, BENCH_CT);
+    List* list = List__alloc(_G->arena);
+    for (u32 i = 0; i < BENCH_CT; i++) {
+      objs[i].id = i;
+      handles[i] = Objs__insert(&m, objs[i]);
+      List__append(_G->arena, list, &objs[i]);
+    }
+
+    // remove in a scattered order, the way disconnects arrive
+    u64 start = Time__perf_now();
+    for (u32 i = 0; i < BENCH_CT; i++) {
+      Objs__remove(&m, handles[(i * 7919) % BENCH_CT]);
+    }
+    u64 slotNs = Time__perf_now() - start;
+    start = Time__perf_now();
+    for (u32 i = 0; i < BENCH_CT; i++) {
+      List__remove_item(list, &objs[(i * 7919) % BENCH_CT]);
+    }
+    u64 listNs = Time__perf_now() - start;
+    ASSERT(0 == m.len && 0 == list->len);
+    LOG_DEBUGF(
+        "remove %u items: SlotMap %6llu us  List %6llu us",
+        BENCH_CT,
+        Time__us(slotNs),
+        Time__us(listNs));
+  }
+
+  return 0;
+}
\ No newline at end of file
@@ -0,0 +1,173 @@
+#define UNIT_TEST
+
+#include "../../../src/unity.h"  // IWYU pragma: keep
+
+typedef struct {
+  f32 prio;
+  u32 id;
+} Snap;
+
+#define Snap__less(a, b) ((a).prio > (b).prio)  // highest first
+#define Snap__key(s) (~Sort__keyF32((s).prio))
+
+GENERIC_SORT_FNS(U32s, u32, SORT__LESS);
+GENERIC_RADIX_FNS(U32sR, u32, u32, Sort__keyU32);
+GENERIC_RADIX_FNS(S32sR, s32, u32, Sort__keyS32);
+GENERIC_RADIX_FNS(U64sR, u64, u64, Sort__keyU64);
+GENERIC_SORT_FNS(Snaps, Snap, Snap__less);
+GENERIC_RADIX_FNS(SnapsR, Snap, u32, Snap__key);
+
+#define BENCH_CT (10000)
+
+static u32 _rand(u32* seed) {
+  *seed = *seed * 1664525u + 1013904223u;
+  return *seed;
+}
+
+static int _u32__cmp(const void* a, const void* b) {
+  u32 x = *(const u32*)a, y = *(const u32*)b;
+  return x < y ? -1 : x > y;
+}
+
+static int _Snap__cmp(const void* a, const void* b) {
+  f32 x = ((const Snap*)a)->prio, y = ((const Snap*)b)->prio;
+  return x > y ? -1 : x < y;
+}
+
+static bool _u32__sorted(const u32* a, u32 n) {
+  for (u32 i = 1; i < n; i++) {
+    if (a[i] < a[i - 1]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// @describe Sort
+// @tag common
+int main() {
+  _G->arena = Arena__allocZ(4 * 1024 * 1024);
+
+  // ---
+  // Scenario: Introsort + radix agree with qsort on random and adversarial inputs
+  {
+    enum { CT = 3000 };
+    u32* a = Arena__pushArray(_G->arena, u32, CT);
+    u32* b = Arena__pushArray(_G->arena, u32, CT);
+    u32* c = Arena__pushArray(_G->arena, u32, CT);
+    u32 seed = 1;
+    for (u32 pattern = 0; pattern < 6; pattern++) {
+      for (u32 n = 0; n <= CT; n = n < 40 ? n + 1 : n * 3) {
+        for (u32 i = 0; i < n; i++) {
+          u32 v = _rand(&seed);
+          a[i] = 0 == pattern   ? v
+                 : 1 == pattern ? i  // sorted
+                 : 2 == pattern ? n - i  // reversed
+                 : 3 == pattern ? 7  // all equal
+                 : 4 == pattern ? v % 4  // few distinct
+                                : (i & 1 ? i : n - i);  // organ pipe
+        }
+        memcpy(b, a, n * sizeof(u32));
+        memcpy(c, a, n * sizeof(u32));
+        qsort(a, n, sizeof(u32), _u32__cmp);
+        U32s__sort(b, n);
+        bool ok = U32sR__radix(c, n, _G->arena);
+        ASSERT(ok);
+        ASSERT_CONTEXT(0 == memcmp(a, b, n * sizeof(u32)), "introsort pattern %u n %u", pattern, n);
+        ASSERT_CONTEXT(0 == memcmp(a, c, n * sizeof(u32)), "radix pattern %u n %u", pattern, n);
+      }
+    }
+  }
+
+  // ---
+  // Scenario: Signed, 64-bit and float keys; radix is stable and frees its scratch
+  {
+    s32 s[] = {5, -3, 0, INT32_MIN, INT32_MAX, -1, 2};
+    S32sR__radix(s, ARRAYSIZE(s), _G->arena);
+    ASSERT(INT32_MIN == s[0] && -3 == s[1] && -1 == s[2] && 0 == s[3] && INT32_MAX == s[6]);
+
+    u64 w[] = {1ull << 40, 3, 1ull << 63, 0, 1ull << 40 | 1};
+    U64sR__radixRange(ARANGE(w), _G->arena);
+    ASSERT(0 == w[0] && 3 == w[1] && (1ull << 40) == w[2] && (1ull << 63) == w[4]);
+
+    Snap snaps[] = {
+        {.prio = 0.5f, .id = 0},
+        {.prio = -2.0f, .id = 1},
+        {.prio = 3.0f, .id = 2},
+        {.prio = 0.5f, .id = 3},
+        {.prio = -0.0f, .id = 4},
+        {.prio = 0.5f, .id = 5},
+    };
+    u8* pos = _G->arena->pos;
+    SnapsR__radix(snaps, ARRAYSIZE(snaps), _G->arena);
+    ASSERT(pos == _G->arena->pos);
+    ASSERT(2 == snaps[0].id && 1 == snaps[5].id && 4 == snaps[4].id);
+    ASSERT(0 == snaps[1].id && 3 == snaps[2].id && 5 == snaps[3].id);  // ties keep input order
+
+    Snaps__sortRange(ARANGE(snaps));
+    for (u32 i = 1; i < ARRAYSIZE(snaps); i++) {
+      ASSERT(snaps[i - 1].prio >= snaps[i].prio);
+    }
+  }
+
+  // ---
+  // Scenario: Benchmark vs qsort at 10k entities
+  {
+    u32* keys = Arena__pushArray(_G->arena, u32, BENCH_CT);
+    u32* a = Arena__pushArray(_G->arena, u32, BENCH_CT);
+    Snap* snaps = Arena__pushArray(_G->arena, Snap, BENCH_CT);
+    Snap* s = Arena__pushArray(_G->arena, Snap, BENCH_CT);
+    u32 seed = 42;
+    for (u32 i = 0; i < BENCH_CT; i++) {
+      keys[i] = _rand(&seed);
+      snaps[i] = (Snap){.prio = (f32)(_rand(&seed) >> 8) / 1024.0f - 8000.0f, .id = i};
+    }
+
+    u64 ns[6];
+    u64 start = Time__perf_now();
+    memcpy(a, keys, sizeof(u32) * BENCH_CT);
+    qsort(a, BENCH_CT, sizeof(u32), _u32__cmp);
+    ns[0] = Time__perf_now() - start;
+    start = Time__perf_now();
+    memcpy(a, keys, sizeof(u32) * BENCH_CT);
+    U32s__sort(a, BENCH_CT);
+    ns[1] = Time__perf_now() - start;
+    ASSERT(_u32__sorted(a, BENCH_CT));
+    start = Time__perf_now();
+    memcpy(a, keys, sizeof(u32) * BENCH_CT);
+    U32sR__radix(a, BENCH_CT, _G->arena);
+    ns[2] = Time__perf_now() - start;
+    ASSERT(_u32__sorted(a, BENCH_CT));
+
+    start = Time__perf_now();
+    memcpy(s, snaps, sizeof(Snap) * BENCH_CT);
+    qsort(s, BENCH_CT, sizeof(Snap), _Snap__cmp);
+    ns[3] = Time__perf_now() - start;
+    start = Time__perf_now();
+    memcpy(s, snaps, sizeof(Snap) * BENCH_CT);
+    Snaps__sort(s, BENCH_CT);
+    ns[4] = Time__perf_now() - start;
+    start = Time__perf_now();
+    memcpy(s, snaps, sizeof(Snap) * BENCH_CT);
+    SnapsR__radix(s, BENCH_CT, _G->arena);
+    ns[5] = Time__perf_now() - start;
+    for (u32 i = 1; i < BENCH_CT; i++) {
+      ASSERT(s[i - 1].prio >= s[i].prio);
+    }
+
+    LOG_DEBUGF(
+        "sort %u u32:  qsort %5llu us  introsort %5llu us  radix %5llu us",
+        BENCH_CT,
+        Time__us(ns[0]),
+        Time__us(ns[1]),
+        Time__us(ns[2]));
+    LOG_DEBUGF(
+        "sort %u Snap: qsort %5llu us  introsort %5llu us  radix %5llu us",
+        BENCH_CT,
+        Time__us(ns[3]),
+        Time__us(ns[4]),
+        Time__us(ns[5]));
+  }
+
+  return 0;
+}
\ No newline at end of file
@@ -0,0 +1,146 @@
+#define UNIT_TEST
+
+#include "../../../src/unity.h"  // IWYU pragma: keep
+
+#define WORDS (256)  // 2 KB payload; large enough that a torn copy would show
+#define PUBLISHES (20000)
+#define READERS (3)
+
+static StateBuf _sb;
+static u32 _done;
+static u32 _readerErrors;
+
+// fill every word with the version about to be published
+static void _Test__write(StateBuf* sb) {
+  u64* w = (u64*)StateBuf__begin(sb, false);
+  u64 next = sb->version + 1;
+  for (u32 i = 0; i < WORDS; i++) {
+    w[i] = next;
+  }
+  StateBuf__publish(sb);
+}
+
+// publish PUBLISHES versions as fast as possible
+THREAD_FN_RET _Test__writer(THREAD_FN_PARAM1 userdata) {
+  StateBuf* sb = (StateBuf*)userdata;
+  for (u32 i = 0; i < PUBLISHES; i++) {
+    _Test__write(sb);
+  }
+  Atomic__store(&_done, 1);
+  return THREAD_FN_RET_VAL;
+}
+
+// every view must be whole (all words == version) and never older than the last one seen
+THREAD_FN_RET _Test__reader(THREAD_FN_PARAM1 userdata) {
+  u64 last = 0;
+  u32 errors = 0;
+  while (!Atomic__load(&_done)) {
+    StateView v = StateBuf__acquire(&_sb);
+    if (NULL != v.data) {
+      const u64* r = (const u64*)v.data;
+      for (u32 i = 0; i < WORDS; i++) {
+        errors += r[i] != v.version;
+      }
+      errors += v.version < last;
+      last = v.version;
+    }
+    StateBuf__release(&_sb, v);
+  }
+  Atomic__add(&_readerErrors, errors);
+  return THREAD_FN_RET_VAL;
+}
+
+// ct=2 writer; reports once begin() got a buffer
+static u32 _began;
+THREAD_FN_RET _Test__blockedWriter(THREAD_FN_PARAM1 userdata) {
+  StateBuf* sb = (StateBuf*)userdata;
+  StateBuf__begin(sb, true);
+  Atomic__store(&_began, 1);
+  StateBuf__publish(sb);
+  return THREAD_FN_RET_VAL;
+}
+
+// @describe StateBuf
+// @tag common
+int main() {
+  _G->arena = Arena__allocZ(64 * 1024);
+
+  // ---
+  // Scenario: Single thread publish then read
+  {
+    StateBuf sb;
+    StateBuf__init(&sb, _G->arena, WORDS * sizeof(u64), 3);
+    ASSERT(0 == StateBuf__version(&sb));
+    StateView v = StateBuf__acquire(&sb);
+    ASSERT(NULL == v.data && 0 == v.version);  // nothing published yet
+    StateBuf__release(&sb, v);
+
+    for (u32 i = 1; i <= 5; i++) {
+      _Test__write(&sb);
+      ASSERT(i == StateBuf__version(&sb));
+      v = StateBuf__acquire(&sb);
+      const u64* r = (const u64*)v.data;
+      ASSERT(i == v.version && i == r[0] && i == r[WORDS - 1]);
+      StateBuf__release(&sb, v);
+    }
+
+    // copyForward starts from the last published state
+    u64* w = (u64*)StateBuf__begin(&sb, true);
+    ASSERT(5 == w[0] && 5 == w[WORDS - 1]);
+    w[0] = 99;
+    u64 version = StateBuf__publish(&sb);
+    v = StateBuf__acquire(&sb);
+    ASSERT(6 == version && 99 == ((const u64*)v.data)[0] && 5 == ((const u64*)v.data)[1]);
+    StateBuf__release(&sb, v);
+    ASSERT(0 == sb.stalls);
+  }
+
+  // ---
+  // Scenario: Readers never see a torn or older version while a writer publishes
+  {
+    StateBuf__init(&_sb, _G->arena, WORDS * sizeof(u64), 3);
+    _done = 0;
+    _readerErrors = 0;
+    Thread threads[1 + READERS];
+    for (u32 i = 0; i < READERS; i++) {
+      bool ok = Thread__create(&threads[1 + i], _Test__reader, NULL);
+      ASSERT(ok);
+    }
+    bool ok = Thread__create(&threads[0], _Test__writer, &_sb);
+    ASSERT(ok);
+    Thread__join(threads, 1 + READERS);
+    Thread__destroy(threads, 1 + READERS);
+    ASSERT(0 == _readerErrors);
+    ASSERT(PUBLISHES == StateBuf__version(&_sb));
+    LOG_DEBUGF("%u publishes, %llu writer stalls", PUBLISHES, (unsigned long long)_sb.stalls);
+  }
+
+  // ---
+  // Scenario: Double buffer; writer waits until the reader releases the back buffer
+  {
+    StateBuf sb;
+    StateBuf__init(&sb, _G->arena, WORDS * sizeof(u64), 2);
+    _Test__write(&sb);  // v1 in buffer A
+    StateView old = StateBuf__acquire(&sb);
+    _Test__write(&sb);  // v2 in buffer B; reader still pins A
+    ASSERT(1 == old.version && 2 == StateBuf__version(&sb));
+
+    _began = 0;
+    Thread t;
+    bool ok = Thread__create(&t, _Test__blockedWriter, &sb);
+    ASSERT(ok);
+    for (u32 i = 0; i < 1000 && 0 == Atomic__load(&sb.stalls); i++) {
+      Time__sleep_ms(1);
+    }
+    Time__sleep_ms(20);
+    ASSERT(1 == Atomic__load(&sb.stalls) && 0 == Atomic__load(&_began));
+    ASSERT(1 == ((const u64*)old.data)[0]);  // pinned buffer untouched
+
+    StateBuf__release(&sb, old);
+    Thread__join(&t, 1);
+    Thread__destroy(&t, 1);
+    ASSERT(1 == _began && 3 == StateBuf__version(&sb));
+  }
+
+  return 0;
+}
\ No newline at end of file
@@ -0,0 +1,142 @@
+#define UNIT_TEST
+
+#include "../../../src/unity.h"  // IWYU pragma: keep
+
+#define BENCH_CT (20000)
+
+static const char* _KEYS[] = {"alpha", "beta", "gamma", "delta", "epsilon", "zeta", "eta", "theta"};
+static StrId _ids[ARRAYSIZE(_KEYS)];
+
+static const char* _DOC =
+    "{\"alpha\":1,\"beta\":2,\"gamma\":3,\"delta\":4,"
+    "\"epsilon\":5,\"zeta\":6,\"eta\":7,\"theta\":8,\"unknown\":9}";
+
+// sum of value * (key index + 1), dispatching on key text
+static u32 _Doc__sumCstr(Json* json) {
+  u32 sum = 0;
+  Str8 key;
+  Json__object_begin(json);
+  while (Json__object_key(json, &key)) {
+    u32 v = 0;
+    Json__u32(json, &v);
+    for (u32 k = 0; k < ARRAYSIZE(_KEYS); k++) {
+      if (key.len == cstr__len(_KEYS[k]) && cstr__eq(key.len, _KEYS[k], key.str)) {
+        sum += v * (k + 1);
+        break;
+      }
+    }
+  }
+  Json__object_end(json);
+  return sum;
+}
+
+// same, dispatching on interned id
+static u32 _Doc__sumId(Json* json) {
+  u32 sum = 0;
+  StrId key;
+  Json__object_begin(json);
+  while (Json__object_key_id(json, &key)) {
+    u32 v = 0;
+    Json__u32(json, &v);
+    for (u32 k = 0; k < ARRAYSIZE(_KEYS); k++) {
+      if (_ids[k] == key) {
+        sum += v * (k + 1);
+        break;
+      }
+    }
+  }
+  Json__object_end(json);
+  return sum;
+}
+
+// @describe String
+// @tag common
+int main() {
+  _G->arena = Arena__allocZ(1024 * 1024);
+
+  // ---
+  // Scenario: cstr__format truncates to maxlen and gives back the unused tail
+  {
+    u8* pos = _G->arena->pos;
+    char* s = cstr__format(_G->arena, 8, "hello %s", "world");
+    ASSERT(0 == strcmp("hello w", s));
+    ASSERT((u8*)s == pos && _G->arena->pos == pos + 8);
+
+    s = cstr__format(_G->arena, 64, "%u-%u", 12, 345);
+    ASSERT(0 == strcmp("12-345", s) && _G->arena->pos == (u8*)s + 7);
+  }
+
+  // ---
+  // Scenario: Equal text gets one id and shares one copy
+  {
+    StrId none = Str8__find(&(Str8){.str = "hello"});
+    ASSERT(STR8__ID_NONE == none);
+    char buf[] = "hello world";
+    StrId a = Str8__intern(&(Str8){.str = "hello"});
+    StrId b = Str8__intern(&(Str8){.str = buf, .len = 5, .slice = true});
+    StrId c = Str8__intern(&(Str8){.str = "world"});
+    ASSERT(STR8__ID_NONE != a && a == b && a != c);
+    ASSERT(a == Str8__find(&(Str8){.str = buf, .len = 5, .slice = true}));
+
+    Str8 s = Str8__interned(a);
+    ASSERT(5 == s.len && 0 == s.str[5] && STR_ARENA1 == s.life && !s.mut);
+    ASSERT(s.str == Str8__interned(b).str && s.str != buf);  // one copy, not the caller's buffer
+    buf[0] = 'j';
+    ASSERT(0 == strcmp("hello", Str8__interned(a).str));
+    ASSERT(0 == Str8__interned(STR8__ID_NONE).len);
+  }
+
+  // ---
+  // Scenario: Ids stay stable as the table grows
+  {
+    StrId first = Str8__intern(&(Str8){.str = "k0"});
+    char name[16];
+    for (u32 i = 0; i < 1000; i++) {
+      snprintf(name, sizeof(name), "k%u", i);
+      StrId id = Str8__intern(&(Str8){.str = name});
+      ASSERT(STR8__ID_NONE != id);
+    }
+    ASSERT(first == Str8__find(&(Str8){.str = "k0"}));
+    ASSERT(0 == strcmp("k999", Str8__interned(Str8__find(&(Str8){.str = "k999"})).str));
+  }
+
+  // ---
+  // Scenario: Json keys dispatch by id; key_is no longer matches a longer key's prefix
+  {
+    for (u32 k = 0; k < ARRAYSIZE(_KEYS); k++) {
+      _ids[k] = Str8__intern(&(Str8){.str = (char*)_KEYS[k]});
+    }
+    Json json = {.data = {.str = (char*)_DOC, .slice = false}, .file_path = "test"};
+    Str8__init(&json.data);
+    u32 sum = _Doc__sumId(&json);
+    ASSERT(204 == sum);  // 1*1 + 2*2 + ... + 8*8; "unknown" ignored
+
+    Json j2 = {.data = {.str = "{\"nameX\":1}"}, .file_path = "test"};
+    Str8__init(&j2.data);
+    Json__object_begin(&j2);
+    bool is = Json__object_key_is(&j2, 4, "name");
+    ASSERT(!is);
+
+    u64 start = Time__perf_now();
+    u32 total = 0;
+    for (u32 i = 0; i < BENCH_CT; i++) {
+      json.cur = 0;
+      total += _Doc__sumCstr(&json);
+    }
+    u64 cstrNs = Time__perf_now() - start;
+    start = Time__perf_now();
+    for (u32 i = 0; i < BENCH_CT; i++) {
+      json.cur = 0;
+      total -= _Doc__sumId(&json);
+    }
+    u64 idNs = Time__perf_now() - start;
+    ASSERT(0 == total);
+    LOG_DEBUGF(
+        "parse + dispatch %u docs: strncmp %6llu us  interned id %6llu us",
+        BENCH_CT,
+        Time__us(cstrNs),
+        Time__us(idNs));
+  }
+
+  return 0;
+}
\ No newline at end of file
@@ -0,0 +1,251 @@
+#define UNIT_TEST
+
+#include "../../../src/unity.h"  // IWYU pragma: keep
+
+#define WORKERS (4)
+#define ITERS (50000)
+#define READ_PCT (90)
+
+// lock under test, driven through function pointers so every variant pays the same call cost
+typedef struct {
+  const char* name;
+  void (*lock)(void*);
+  void (*unlock)(void*);
+  void (*readLock)(void*);  // NULL = use lock
+  void (*readUnlock)(void*);
+  void* obj;
+} LockOps;
+
+static LockOps* _ops;
+static u64 _counter;
+static u64 _shared[8];  // guarded state; readers sum, writers bump every slot
+
+static void _SyncMutex__lock(void* p) {
+  SyncMutex__lock((SyncMutex*)p);
+}
+static void _SyncMutex__unlock(void* p) {
+  SyncMutex__unlock((SyncMutex*)p);
+}
+static void _TicketLock__lock(void* p) {
+  TicketLock__lock((TicketLock*)p);
+}
+static void _TicketLock__unlock(void* p) {
+  TicketLock__unlock((TicketLock*)p);
+}
+static void _RWLock__writeLock(void* p) {
+  RWLock__writeLock((RWLock*)p);
+}
+static void _RWLock__writeUnlock(void* p) {
+  RWLock__writeUnlock((RWLock*)p);
+}
+static void _RWLock__readLock(void* p) {
+  RWLock__readLock((RWLock*)p);
+}
+static void _RWLock__readUnlock(void* p) {
+  RWLock__readUnlock((RWLock*)p);
+}
+static void _pthread_mutex_lock(void* p) {
+  pthread_mutex_lock((pthread_mutex_t*)p);
+}
+static void _pthread_mutex_unlock(void* p) {
+  pthread_mutex_unlock((pthread_mutex_t*)p);
+}
+static void _pthread_spin_lock(void* p) {
+  pthread_spin_lock((pthread_spinlock_t*)p);
+}
+static void _pthread_spin_unlock(void* p) {
+  pthread_spin_unlock((pthread_spinlock_t*)p);
+}
+static void _pthread_rwlock_wrlock(void* p) {
+  pthread_rwlock_wrlock((pthread_rwlock_t*)p);
+}
+static void _pthread_rwlock_rdlock(void* p) {
+  pthread_rwlock_rdlock((pthread_rwlock_t*)p);
+}
+static void _pthread_rwlock_unlock(void* p) {
+  pthread_rwlock_unlock((pthread_rwlock_t*)p);
+}
+
+// exclusive increments; lost updates mean the lock is broken
+THREAD_FN_RET _Sync__incWorker(THREAD_FN_PARAM1 userdata) {
+  for (u32 i = 0; i < ITERS; i++) {
+    _ops->lock(_ops->obj);
+    _counter++;
+    _ops->unlock(_ops->obj);
+  }
+  return THREAD_FN_RET_VAL;
+}
+
+// mostly-read workload; a reader must never see a half-written _shared
+THREAD_FN_RET _Sync__rwWorker(THREAD_FN_PARAM1 userdata) {
+  u32 seed = (u32)(uintptr_t)userdata * 2654435761u + 1;
+  for (u32 i = 0; i < ITERS; i++) {
+    seed = seed * 1664525u + 1013904223u;
+    if ((seed >> 16) % 100 < READ_PCT) {
+      _ops->readLock(_ops->obj);
+      u64 first = _shared[0];
+      for (u32 j = 1; j < ARRAYSIZE(_shared); j++) {
+        ASSERT_CONTEXT(first == _shared[j], "torn read at slot %u", j);
+      }
+      _ops->readUnlock(_ops->obj);
+    } else {
+      _ops->lock(_ops->obj);
+      for (u32 j = 0; j < ARRAYSIZE(_shared); j++) {
+        _shared[j]++;
+      }
+      _ops->unlock(_ops->obj);
+    }
+  }
+  return THREAD_FN_RET_VAL;
+}
+
+// run fn on WORKERS threads against ops
+// @returns elapsed ns
+static u64 _Sync__run(LockOps* ops, thread_fn_t fn) {
+  _ops = ops;
+  if (NULL == ops->readLock) {
+    ops->readLock = ops->lock;
+    ops->readUnlock = ops->unlock;
+  }
+  _counter = 0;
+  memset(_shared, 0, sizeof(_shared));
+  Thread t[WORKERS];
+  u64 start = Time__perf_now();
+  for (u32 i = 0; i < WORKERS; i++) {
+    bool created = Thread__create(&t[i], fn, (void*)(uintptr_t)i);
+    ASSERT_CONTEXT(created, "Failed to create worker %u", i);
+  }
+  Thread__join(t, WORKERS);
+  Thread__destroy(t, WORKERS);
+  u64 ns = Time__perf_now() - start;
+  LOG_DEBUGF(
+      "%-16s %u threads x %u ops: %6llu us (%llu ns/op)",
+      ops->name,
+      WORKERS,
+      ITERS,
+      Time__us(ns),
+      ns / (WORKERS * ITERS));
+  return ns;
+}
+
+static Event _ping, _pong;
+
+// answer each ping with a pong
+THREAD_FN_RET _Sync__ponger(THREAD_FN_PARAM1 userdata) {
+  for (u32 i = 0; i < 1000; i++) {
+    Event__wait(&_ping, 0);
+    Event__set(&_pong);
+  }
+  return THREAD_FN_RET_VAL;
+}
+
+// @describe Sync
+// @tag common
+int main() {
+  _G->arena = Arena__allocZ(1024 * 1024);
+
+  // ---
+  // Scenario: Mutex create reports success
+  {
+    Mutex m;
+    bool created = Thread__Mutex_create(&m);
+    ASSERT(created);
+    Thread__Mutex_destroy(&m);
+  }
+
+  // ---
+  // Scenario: Uncontended SyncMutex + tryLock
+  {
+    SyncMutex m = {0};
+    bool locked = SyncMutex__tryLock(&m);
+    ASSERT(locked);
+    bool again = SyncMutex__tryLock(&m);
+    ASSERT(!again);
+    SyncMutex__unlock(&m);
+    SyncMutex__lock(&m);
+    ASSERT(1 == m.state);  // no waiters, so unlock() skips the syscall
+    SyncMutex__unlock(&m);
+  }
+
+  // ---
+  // Scenario: Exclusive locks under contention, vs pthread
+  {
+    SyncMutex sm = {0};
+    TicketLock tl = {0};
+    pthread_mutex_t pm;
+    pthread_spinlock_t ps;
+    pthread_mutex_init(&pm, NULL);
+    pthread_spin_init(&ps, PTHREAD_PROCESS_PRIVATE);
+
+    LockOps ops[] = {
+        {"SyncMutex", _SyncMutex__lock, _SyncMutex__unlock, NULL, NULL, &sm},
+        {"pthread_mutex", _pthread_mutex_lock, _pthread_mutex_unlock, NULL, NULL, &pm},
+        {"TicketLock", _TicketLock__lock, _TicketLock__unlock, NULL, NULL, &tl},
+        {"pthread_spin", _pthread_spin_lock, _pthread_spin_unlock, NULL, NULL, (void*)&ps},
+    };
+    for (u32 i = 0; i < ARRAYSIZE(ops); i++) {
+      _Sync__run(&ops[i], _Sync__incWorker);
+      ASSERT_CONTEXT(WORKERS * ITERS == _counter, "%s lost updates: %llu", ops[i].name, _counter);
+    }
+    pthread_mutex_destroy(&pm);
+    pthread_spin_destroy(&ps);
+  }
+
+  // ---
+  // Scenario: RWLock with mostly-read workload, vs pthread
+  {
+    RWLock rw = {0};
+    SyncMutex sm = {0};
+    pthread_rwlock_t prw;
+    pthread_rwlock_init(&prw, NULL);
+
+    LockOps ops[] = {
+        {"RWLock",
+         _RWLock__writeLock,
+         _RWLock__writeUnlock,
+         _RWLock__readLock,
+         _RWLock__readUnlock,
+         &rw},
+        {"pthread_rwlock",
+         _pthread_rwlock_wrlock,
+         _pthread_rwlock_unlock,
+         _pthread_rwlock_rdlock,
+         _pthread_rwlock_unlock,
+         &prw},
+        {"SyncMutex (rw)", _SyncMutex__lock, _SyncMutex__unlock, NULL, NULL, &sm},
+    };
+    for (u32 i = 0; i < ARRAYSIZE(ops); i++) {
+      _Sync__run(&ops[i], _Sync__rwWorker);
+    }
+    ASSERT(0 == rw.state && 0 == rw.waiters);
+    pthread_rwlock_destroy(&prw);
+  }
+
+  // ---
+  // Scenario: Event ping-pong between threads; timeout when unsignaled
+  {
+    Thread t[1];
+    bool created = Thread__create(&t[0], _Sync__ponger, NULL);
+    ASSERT(created);
+    u64 start = Time__perf_now();
+    for (u32 i = 0; i < 1000; i++) {
+      Event__set(&_ping);
+      Event__wait(&_pong, 0);
+    }
+    LOG_DEBUGF("Event round trip: %llu ns", (Time__perf_now() - start) / 1000);
+    Thread__join(t, 1);
+    Thread__destroy(t, 1);
+
+    Event e = {0};
+    bool woke = Event__wait(&e, 5);
+    ASSERT(!woke);
+    Event__set(&e);
+    Event__set(&e);  // auto-reset: signals don't stack
+    woke = Event__wait(&e, 5);
+    ASSERT(woke);
+    woke = Event__wait(&e, 5);
+    ASSERT(!woke);
+  }
+
+  return 0;
+}
\ No newline at end of file
@@ -7,6 +7,11 @@ THREAD_FN_RET _Thread__worker(THREAD_FN_PARAM1 userdata) {
   u32 threadId = (u32)(uintptr_t)userdata;
   LOG_DEBUGF("Worker thread %u started\n", threadId);
 
+  // each thread gets its own arenas, separate from the main thread's
+  ThreadCtx* ctx = ThreadCtx__get();
+  ASSERT_CONTEXT(0 != ctx->id, "Thread %u has main thread context\n", threadId);
+  ASSERT(ctx->arena != _G->arena && ctx->frameArena != _G->frameArena);
+
   // Simulate processing 5 work items
   for (u32 i = 0; i < 5; i++) {
     LOG_DEBUGF("Thread %u processing item %u\n", threadId, i);
@@ -17,6 +22,13 @@ THREAD_FN_RET _Thread__worker(THREAD_FN_PARAM1 userdata) {
   return THREAD_FN_RET_VAL;
 }
 
+// Pinned + prefaulted thread; reports which attributes the OS granted
+THREAD_FN_RET _Thread__pinned(THREAD_FN_PARAM1 userdata) {
+  u32* flags = (u32*)userdata;
+  *flags = ThreadCtx__get()->flags;
+  return THREAD_FN_RET_VAL;
+}
+
 // @describe Thread
 // @tag common
 int main() {
@@ -43,5 +55,32 @@ int main() {
   Thread__destroy(threads, numThreads);
   LOG_DEBUGF("All worker threads completed\n");
 
+  // Create a thread pinned to the first core we may run on, with prefaulted arenas + stack
+  // (core 0 can be outside the allowed set under taskset/cgroup cpusets)
+  ThreadAttr attr = THREAD_ATTR_DEFAULT;
+  attr.core = 0;
+#ifdef __linux__
+  cpu_set_t allowed;
+  CPU_ZERO(&allowed);
+  if (0 == sched_getaffinity(0, sizeof(allowed), &allowed)) {
+    for (s32 c = 0; c < CPU_SETSIZE; c++) {
+      if (CPU_ISSET(c, &allowed)) {
+        attr.core = c;
+        break;
+      }
+    }
+  }
+#endif
+  LOG_DEBUGF("Pinning to core %d\n", attr.core);
+  attr.prefault = true;
+  u32 flags = 0;
+  bool created = Thread__createAttr(&threads[0], _Thread__pinned, &flags, &attr);
+  ASSERT_CONTEXT(created, "Failed to create pinned thread\n");
+  Thread__join(threads, 1);
+  Thread__destroy(threads, 1);
+  ASSERT(flags & THREAD__PINNED);
+  ASSERT(flags & THREAD__PREFAULTED);
+  ASSERT(!(flags & THREAD__REALTIME));  // not requested
+
   return 0;
 }
\ No newline at end of file
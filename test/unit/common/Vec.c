@@ -0,0 +1,104 @@
+#define UNIT_TEST
+
+#include "../../../src/unity.h"  // IWYU pragma: keep
+
+GENERIC_VEC(U32Vec, u32);
+GENERIC_VEC_FNS(U32Vec, u32);
+
+static int _Vec__cmpU32(const void* a, const void* b) {
+  u32 x = *(const u32*)a, y = *(const u32*)b;
+  return (x > y) - (x < y);
+}
+
+#define BENCH_CT (100000)
+
+// @describe Vec
+// @tag common
+int main() {
+  _G->arena = Arena__allocZ(16 * 1024 * 1024);
+
+  // ---
+  // Scenario: Push grows in place while the vec is on top of the arena
+  {
+    U32Vec v;
+    U32Vec__init(&v, _G->arena, 0);
+    for (u32 i = 0; i < 100; i++) {
+      U32Vec__push(&v, i);
+    }
+    u32* first = v.data;
+    ASSERT(100 == v.len && 128 == v.cap && 99 == *U32Vec__get(&v, 99));
+    U32Vec__push(&v, 100);
+    ASSERT(first == v.data);  // never moved: nothing else pushed in between
+
+    Arena__push(_G->arena, 1);
+    U32Vec__reserve(&v, 1024);
+    ASSERT(first != v.data && 100 == v.data[100] && 0 == (uintptr_t)v.data % _Alignof(u32));
+  }
+
+  // ---
+  // Scenario: Insert, remove, swapRemove, pop, sort, iterate
+  {
+    U32Vec v;
+    U32Vec__init(&v, _G->arena, 4);
+    u32 in[] = {5, 1, 4, 2};
+    for (u32 i = 0; i < ARRAYSIZE(in); i++) {
+      U32Vec__push(&v, in[i]);
+    }
+    U32Vec__insert(&v, 1, 9);  // 5 9 1 4 2
+    ASSERT(5 == v.len && 9 == v.data[1] && 1 == v.data[2]);
+    U32Vec__remove(&v, 0);  // 9 1 4 2
+    ASSERT(9 == v.data[0] && 2 == v.data[3]);
+    U32Vec__swapRemove(&v, 0);  // 2 1 4
+    ASSERT(3 == v.len && 2 == v.data[0]);
+    U32Vec__sort(&v, _Vec__cmpU32);  // 1 2 4
+
+    u32 sum = 0;
+    U32VecIt it = {&v};
+    while (U32VecIt__each(&it)) {
+      ASSERT(*it.item == v.data[it.i]);
+      sum += *it.item * (it.i + 1);
+    }
+    ASSERT(1 + 2 * 2 + 4 * 3 == sum);
+
+    u32 last;
+    ASSERT(U32Vec__pop(&v, &last) && 4 == last && 2 == v.len);
+    U32Vec__clear(&v);
+    ASSERT(!U32Vec__pop(&v, &last) && NULL == U32Vec__get(&v, 0));
+    U32VecIt empty = {&v};
+    ASSERT(!U32VecIt__each(&empty));
+  }
+
+  // ---
+  // Scenario: Benchmark sequential sum, Vec vs List
+  {
+    U32Vec v;
+    U32Vec__init(&v, _G->arena, BENCH_CT);
+    List* list = List__alloc(_G->arena);
+    for (u32 i = 0; i < BENCH_CT; i++) {
+      U32Vec__push(&v, i);
+      List__append(_G->arena, list, (void*)(uintptr_t)i);
+    }
+    u64 start = Time__perf_now();
+    u64 vecSum = 0;
+    U32VecIt vit = {&v};
+    while (U32VecIt__each(&vit)) {
+      vecSum += *vit.item;
+    }
+    u64 vecNs = Time__perf_now() - start;
+    start = Time__perf_now();
+    u64 listSum = 0;
+    ListIt lit = {list};
+    while (ListIt__each(&lit)) {
+      listSum += (uintptr_t)lit.node->data;
+    }
+    u64 listNs = Time__perf_now() - start;
+    ASSERT(vecSum == listSum);
+    LOG_DEBUGF(
+        "iterate %u items: Vec %5llu us  List %5llu us",
+        BENCH_CT,
+        Time__us(vecNs),
+        Time__us(listNs));
+  }
+
+  return 0;
+}
\ No newline at end of file